@@ -20,6 +20,7 @@ target_sources(ftxui-modules
   src/ftxui/component/screen_interactive.cppm
   src/ftxui/component/task.cppm
   src/ftxui/dom.cppm
+  src/ftxui/dom/arena.cppm
   src/ftxui/dom/canvas.cppm
   src/ftxui/dom/deprecated.cppm
   src/ftxui/dom/direction.cppm
@@ -27,6 +28,7 @@ target_sources(ftxui-modules
   src/ftxui/dom/flexbox_config.cppm
   src/ftxui/dom/linear_gradient.cppm
   src/ftxui/dom/node.cppm
+  src/ftxui/dom/render_pool.cppm
   src/ftxui/dom/requirement.cppm
   src/ftxui/dom/selection.cppm
   src/ftxui/dom/table.cppm
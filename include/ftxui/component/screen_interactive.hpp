@@ -5,6 +5,7 @@
 #define FTXUI_COMPONENT_SCREEN_INTERACTIVE_HPP
 
 #include <atomic>      // for atomic
+#include <cstdint>     // for uint64_t
 #include <functional>  // for function
 #include <memory>      // for shared_ptr
 #include <string>      // for string
@@ -47,6 +48,8 @@ class ScreenInteractive : public Screen {
 
   // Options. Must be called before Loop().
   void TrackMouse(bool enable = true);
+  void UseFrameArena(bool enable = true);
+  void CoalesceMouseMotion(bool enable = true);
 
   // Return the currently active screen, nullptr if none.
   static ScreenInteractive* Active();
@@ -61,6 +64,14 @@ class ScreenInteractive : public Screen {
   void PostEvent(Event event);
   void RequestAnimationFrame();
 
+  // Request a new frame to be drawn. Thread-safe. Any number of requests
+  // received before the next frame are merged into a single redraw.
+  void RequestRedraw();
+  std::uint64_t MergedRedrawRequests() const;
+
+  // The number of mouse motion events dropped by CoalesceMouseMotion().
+  std::uint64_t DroppedMouseEvents() const;
+
   CapturedMouse CaptureMouse();
 
   // Decorate a function. The outputted one will execute similarly to the
@@ -93,6 +104,7 @@ class ScreenInteractive : public Screen {
   bool HasQuitted();
   void RunOnce(Component component);
   void RunOnceBlocking(Component component);
+  void WaitForEvents();
 
   void HandleTask(Component component, Task& task);
   bool HandleSelection(bool handled, Event event);
@@ -103,6 +115,7 @@ class ScreenInteractive : public Screen {
   void Signal(int signal);
 
   void FetchTerminalEvents();
+  void PostTerminalEvents();
 
   void PostAnimationTask();
 
@@ -121,11 +134,16 @@ class ScreenInteractive : public Screen {
   const bool use_alternative_screen_;
 
   bool track_mouse_ = true;
+  bool use_frame_arena_ = false;
+  bool coalesce_mouse_motion_ = true;
 
   std::string set_cursor_position;
   std::string reset_cursor_position;
 
   std::atomic<bool> quit_{false};
+  std::atomic<bool> redraw_requested_{false};
+  std::atomic<std::uint64_t> merged_redraw_requests_{0};
+  std::atomic<std::uint64_t> dropped_mouse_events_{0};
   bool animation_requested_ = false;
   animation::TimePoint previous_animation_time_;
 
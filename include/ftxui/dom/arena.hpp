@@ -0,0 +1,120 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_ARENA_HPP
+#define FTXUI_DOM_ARENA_HPP
+
+#include <cstddef>  // for size_t
+#include <memory>   // for shared_ptr, allocate_shared, make_shared
+#include <utility>  // for forward
+#include <vector>   // for vector
+
+namespace ftxui {
+
+/// @brief A bump allocator for the nodes of a frame.
+///
+/// While an Arena::Scope is alive, the elements created on the current thread
+/// are allocated from the arena, instead of the heap. Freeing them is nearly
+/// free, and Reset() reuses the memory of the previous frame at once.
+///
+/// Elements are allowed to outlive the frame, or the arena: the memory of a
+/// chunk is only reused after every element it holds has been destroyed, on
+/// any thread.
+///
+/// **example**
+/// ```cpp
+/// Arena arena;
+/// while (running) {
+///   arena.Reset();
+///   Arena::Scope scope(&arena);
+///   auto document = RenderDocument();
+///   Render(screen, document);
+/// }
+/// ```
+///
+/// @ingroup dom
+class Arena {
+ public:
+  Arena();
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Reuse the memory of the chunks whose allocations were all released.
+  void Reset();
+
+  void* Allocate(size_t size, size_t alignment);
+  static void Deallocate(void* pointer);
+
+  // The arena used by MakeNode on the current thread. nullptr if none.
+  static Arena* Current();
+
+  // Make |arena| the current one, until the Scope is destroyed.
+  class Scope {
+   public:
+    explicit Scope(Arena* arena);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    Arena* previous_;
+  };
+
+ private:
+  struct Chunk;
+  Chunk* NewChunk(size_t capacity);
+  static void Release(Chunk* chunk);
+
+  std::vector<Chunk*> chunks_;
+  size_t current_ = 0;
+};
+
+/// @brief An allocator using an Arena, for `std::allocate_shared`.
+/// @ingroup dom
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena_) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* pointer, size_t /*n*/) { Arena::Deallocate(pointer); }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+  Arena* arena_;
+};
+
+/// @brief Create a Node. It is allocated from the current Arena if any, or
+/// from the heap otherwise.
+/// @ingroup dom
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeNode(Args&&... args) {
+  Arena* arena = Arena::Current();
+  if (arena == nullptr) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(ArenaAllocator<T>(arena),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_ARENA_HPP
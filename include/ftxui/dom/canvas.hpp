@@ -4,10 +4,11 @@
 #ifndef FTXUI_DOM_CANVAS_HPP
 #define FTXUI_DOM_CANVAS_HPP
 
-#include <cstddef>        // for size_t
+#include <cstdint>        // for uint8_t, uint64_t
 #include <functional>     // for function
 #include <string>         // for string
 #include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
 #include "ftxui/screen/color.hpp"  // for Color
 #include "ftxui/screen/image.hpp"  // for Pixel, Image
@@ -47,6 +48,11 @@ struct Canvas {
 
   using Stylizer = std::function<void(Pixel&)>;
 
+  struct Point {
+    int x = 0;
+    int y = 0;
+  };
+
   // Draws using braille characters --------------------------------------------
   void DrawPointOn(int x, int y);
   void DrawPointOff(int x, int y);
@@ -69,6 +75,8 @@ struct Canvas {
   void DrawPointEllipseFilled(int x, int y, int r1, int r2);
   void DrawPointEllipseFilled(int x, int y, int r1, int r2, const Color& color);
   void DrawPointEllipseFilled(int x, int y, int r1, int r2, const Stylizer& s);
+  void DrawPoints(const std::vector<Point>& points);
+  void DrawPoints(const std::vector<Point>& points, const Color& color);
 
   // Draw using box characters -------------------------------------------------
   // Block are of size 1x2. y is considered to be a multiple of 2.
@@ -121,40 +129,99 @@ struct Canvas {
   // y is considered to be a multiple of 4.
   void Style(int x, int y, const Stylizer& style);
 
+  // Move the whole content by (dx, dy). Uncovered cells are cleared.
+  // dx is considered to be a multiple of 2.
+  // dy is considered to be a multiple of 4.
+  void Scroll(int dx, int dy);
+
  private:
   bool IsIn(int x, int y) const {
     return x >= 0 && x < width_ && y >= 0 && y < height_;
   }
 
-  enum CellType {
+  enum CellType : uint8_t {
     kCell,     // Units of size 2x4
     kBlock,    // Units of size 2x2
     kBraille,  // Units of size 1x1
   };
 
+  // The dots of a cell: a braille pattern, or the 4 quadrants of a block.
   struct Cell {
     CellType type = kCell;
-    Pixel content;
+    uint8_t bits = 0;
   };
 
-  struct XY {
-    int x;
-    int y;
-    bool operator==(const XY& other) const {
-      return x == other.x && y == other.y;
-    }
-  };
+  // Index of the cell containing the dot (x,y).
+  int CellIndex(int x, int y) const { return (y / 4) * cells_x_ + x / 2; }
 
-  struct XYHash {
-    size_t operator()(const XY& xy) const {
-      constexpr size_t shift = 1024;
-      return size_t(xy.x) * shift + size_t(xy.y);
-    }
-  };
+  // Return the pixel holding the style of a cell, creating it if needed.
+  Pixel& StyleAt(int index);
+  void UseDenseStyles();
+
+  // Draw the dots of the row |y|, in between |x_min| and |x_max| included.
+  // The style is applied once per cell.
+  void DrawPointSpan(int x_min, int x_max, int y, const Stylizer& style);
+  void DrawBlockSpan(int x_min, int x_max, int y, const Stylizer& style);
 
   int width_ = 0;
   int height_ = 0;
-  std::unordered_map<XY, Cell, XYHash> storage_;
+  int cells_x_ = 0;
+  int cells_y_ = 0;
+
+  // One byte of dots per cell, stored densely in row-major order.
+  std::vector<Cell> cells_;
+
+  // The style of the cells, and the content of the kCell ones. It is stored in
+  // a map while only a few cells use it, and in a dense vector otherwise.
+  std::unordered_map<int, Pixel> sparse_styles_;
+  std::vector<Pixel> dense_styles_;
+};
+
+/// @brief A Canvas kept in between frames.
+///
+/// The draw function is called only when the size of the canvas changes, or
+/// when the application sets a new version. Otherwise, the canvas from the
+/// previous frame is displayed again. In between, it can also be updated
+/// incrementally using `canvas()`, for instance by scrolling a time series with
+/// `Canvas::Scroll` and drawing only the new values.
+///
+/// ### Example
+///
+/// ```cpp
+/// RetainedCanvas chart([&](Canvas& c) { DrawChart(c, data); });
+/// ...
+/// data.push_back(value);
+/// chart.SetVersion(data.size());
+/// ...
+/// Element element = canvas(&chart);
+/// ```
+///
+/// @ingroup dom
+class RetainedCanvas {
+ public:
+  RetainedCanvas() = default;
+  explicit RetainedCanvas(std::function<void(Canvas&)> draw);
+
+  // The draw function is called again when the version differs from the one
+  // of the last draw.
+  void SetVersion(uint64_t version) { version_ = version; }
+  uint64_t version() const { return version_; }
+
+  // The retained canvas, to be modified incrementally.
+  Canvas& canvas() { return canvas_; }
+
+  // Return a canvas of the given size, calling the draw function if needed.
+  const Canvas& Update(int width, int height);
+
+  // The number of times the draw function was called.
+  int draw_count() const { return draw_count_; }
+
+ private:
+  std::function<void(Canvas&)> draw_;
+  Canvas canvas_;
+  uint64_t version_ = 0;
+  uint64_t drawn_version_ = 0;
+  int draw_count_ = 0;
 };
 
 }  // namespace ftxui
@@ -99,6 +99,8 @@ Element emptyElement();
 Element canvas(ConstRef<Canvas>);
 Element canvas(int width, int height, std::function<void(Canvas&)>);
 Element canvas(std::function<void(Canvas&)>);
+Element canvas(int width, int height, RetainedCanvas*);
+Element canvas(RetainedCanvas*);
 
 // -- Decorator ---
 Element bold(Element);
@@ -70,15 +70,32 @@ class Node {
   struct Status {
     int iteration = 0;
     bool need_iteration = false;
+    // Whether the element was laid out in the same box during the previous
+    // frame. Elements may start from their previous layout.
+    bool same_box = false;
   };
   virtual void Check(Status* status);
 
+  // Layout caching. Same as ComputeRequirement(), SetBox() and Check(), but
+  // skip the subtrees whose layout can't have changed since the previous
+  // iteration: they didn't request another iteration, and are given the same
+  // box. Containers should use them to forward the layout to their children.
+  void CachedComputeRequirement();
+  void CachedSetBox(Box box);
+  void CachedCheck(Status* status);
+
   friend void Render(Screen& screen, Node* node, Selection& selection);
+  friend class RenderPool;
 
  protected:
   Elements children_;
   Requirement requirement_;
   Box box_;
+
+ private:
+  Box layout_box_;
+  bool layout_dirty_ = true;    // The subtree requested another iteration.
+  bool layout_visited_ = true;  // The layout was updated since last Check().
 };
 
 void Render(Screen& screen, const Element& element);
@@ -0,0 +1,71 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_RENDER_POOL_HPP
+#define FTXUI_DOM_RENDER_POOL_HPP
+
+#include <memory>  // for unique_ptr
+
+#include "ftxui/dom/node.hpp"  // for Element
+
+namespace ftxui {
+
+class Screen;
+
+/// @brief A pool of threads, rendering the independent parts of a document in
+/// parallel.
+///
+/// While a RenderPool::Scope is alive, `hbox`, `vbox` and `gridbox` render
+/// their large children in parallel. Their boxes are disjoint, so each one is
+/// drawn on a separate part of the screen. The output is the same as the
+/// sequential rendering, for elements drawing within their box, as all the
+/// builtin ones do.
+///
+/// The Render() of the elements, and the draw functions of the canvases, may
+/// be called from the threads of the pool.
+///
+/// **example**
+/// ```cpp
+/// RenderPool pool(3);
+/// RenderPool::Scope scope(&pool);
+/// Render(screen, document);  // Or ScreenInteractive::Loop(component).
+/// ```
+///
+/// @ingroup dom
+class RenderPool {
+ public:
+  // Start |threads| threads. The thread rendering the document takes part too.
+  explicit RenderPool(int threads);
+  ~RenderPool();
+  RenderPool(const RenderPool&) = delete;
+  RenderPool& operator=(const RenderPool&) = delete;
+
+  // The pool used on the current thread. nullptr if none.
+  static RenderPool* Current();
+
+  // Make |pool| the current one, until the Scope is destroyed.
+  class Scope {
+   public:
+    explicit Scope(RenderPool* pool);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    RenderPool* previous_;
+  };
+
+  // Render the elements in [begin, end), laid out in disjoint boxes. The large
+  // ones are rendered in parallel when a pool is current.
+  static void RenderChildren(Screen& screen,
+                             const Element* begin,
+                             const Element* end);
+
+ private:
+  struct Internal;
+  std::unique_ptr<Internal> internal_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_RENDER_POOL_HPP
@@ -4,8 +4,9 @@
 #ifndef FTXUI_DOM_TABLE
 #define FTXUI_DOM_TABLE
 
-#include <string>  // for string
-#include <vector>  // for vector
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
 
 #include "ftxui/dom/elements.hpp"  // for Element, BorderStyle, LIGHT, Decorator
 
@@ -32,6 +33,16 @@ class TableSelection;
 /// std::move(table).Render();
 /// ```
 ///
+/// A virtualized table pulls its cells from a callback, only for the rows
+/// visible on the screen. It is suitable for millions of rows:
+/// ```cpp
+/// auto table = Table(2, 1000000, [](int column, int row) {
+///   return text(column == 0 ? std::to_string(row) : Name(row));
+/// });
+/// table.SelectAll().Border(LIGHT);
+/// auto element = table.Render() | vscroll_indicator | yframe;
+/// ```
+///
 /// @ingroup dom
 class Table {
  public:
@@ -39,6 +50,10 @@ class Table {
   explicit Table(std::vector<std::vector<std::string>>);
   explicit Table(std::vector<std::vector<Element>>);
   Table(std::initializer_list<std::vector<std::string>> init);
+  Table(int columns,
+        int rows,
+        std::function<Element(int column, int row)> cell);
+  void SetColumnWidths(std::vector<int> widths);
   TableSelection SelectAll();
   TableSelection SelectCell(int column, int row);
   TableSelection SelectRow(int row_index);
@@ -59,6 +74,21 @@ class Table {
   int input_dim_y_ = 0;
   int dim_x_ = 0;
   int dim_y_ = 0;
+
+  // Virtualized tables. |elements_| only holds the rows starting from
+  // |y_begin_|. The TableSelection operations are recorded, and applied to
+  // the rows materialized for rendering.
+  struct Operation {
+    int y_min;
+    int y_max;
+    std::function<void(Table&)> apply;
+  };
+  Element RenderVirtual();
+  Table Materialize(int y_min, int y_max, int operation = -1) const;
+  std::function<Element(int column, int row)> cell_;
+  std::vector<int> column_widths_;
+  std::vector<Operation> operations_;
+  int y_begin_ = 0;
 };
 
 class TableSelection {
@@ -82,6 +112,12 @@ class TableSelection {
   void SeparatorHorizontal(BorderStyle border = LIGHT);
 
  private:
+  bool Defer(std::function<void(TableSelection&)> operation);
+  bool Holds(int y) const;
+  int ClipMin(int y) const;
+  int ClipMax(int y) const;
+  Element& At(int x, int y);
+
   friend Table;
   Table* table_;
   int x_min_;
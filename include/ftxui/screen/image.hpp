@@ -41,9 +41,19 @@ class Image {
   Box stencil;
 
  protected:
+  // A view drawing into the pixels of |target|, restricted to |area|. Used to
+  // render the disjoint parts of an image separately.
+  Image(Image& target, Box area);
+
   int dimx_;
   int dimy_;
-  std::vector<std::vector<Pixel>> pixels_;
+
+  // The pixels, stored contiguously in row-major order. The pixel (x,y) is at
+  // index `y * dimx_ + x`.
+  std::vector<Pixel> pixels_;
+
+  // The image owning the pixels, for a view. nullptr otherwise.
+  Image* target_ = nullptr;
 };
 
 }  // namespace ftxui
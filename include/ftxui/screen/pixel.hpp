@@ -40,13 +40,15 @@ struct Pixel {
   // It's an index for accessing Screen meta data
   uint8_t hyperlink = 0;
 
-  // The graphemes stored into the pixel. To support combining characters,
-  // like: a?, this can potentially contain multiple codepoints.
-  std::string character = "";
-
   // Colors:
+  // Stored before `character`, so that they pack with the style bits above.
   Color background_color = Color::Default;
   Color foreground_color = Color::Default;
+
+  // The graphemes stored into the pixel. To support combining characters,
+  // like: a?, this can potentially contain multiple codepoints. Short
+  // graphemes fit in the string's inline storage and don't allocate.
+  std::string character = "";
 };
 
 }  // namespace ftxui
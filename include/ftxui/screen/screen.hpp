@@ -35,6 +35,14 @@ class Screen : public Image {
 
   std::string ToString() const;
 
+  // Produce the minimal output turning the terminal content from `previous`
+  // into this screen. Falls back to ToString() when the dimensions differ.
+  std::string ToString(const Screen& previous) const;
+
+  // Same as above, but append to `output`, reusing its capacity.
+  void ToString(std::string& output) const;
+  void ToString(const Screen& previous, std::string& output) const;
+
   // Print the Screen on to the terminal.
   void Print() const;
 
@@ -44,6 +52,7 @@ class Screen : public Image {
 
   // Move the terminal cursor n-lines up with n = dimy().
   std::string ResetPosition(bool clear = false) const;
+  void ResetPosition(std::string& output, bool clear = false) const;
 
   void ApplyShader();
 
@@ -76,6 +85,13 @@ class Screen : public Image {
   void SetSelectionStyle(SelectionStyle decorator);
 
  protected:
+  // A view drawing into the pixels of |target|. See Image(Image&, Box).
+  Screen(Screen& target, Box area);
+
+  // Exchange the pixels and the hyperlinks with |other|, without copying them.
+  // This screen keeps its dimensions.
+  void SwapPixels(Screen& other);
+
   Cursor cursor_;
   std::vector<std::string> hyperlinks_ = {""};
 
@@ -0,0 +1,80 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <benchmark/benchmark.h>
+
+#include <cstdint>  // for int64_t
+#include <string>   // for string, to_string
+
+#include "ftxui/component/event.hpp"  // for Event
+#include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
+
+// NOLINTBEGIN
+
+namespace ftxui {
+
+namespace {
+
+// Recorded-like input streams, as a terminal would send them.
+std::string TypingStream() {
+  std::string out;
+  const std::string words[] = {"hello", "wörld", "ftxui", "→", "terminal"};
+  for (int i = 0; i < 1000; ++i) {
+    out += words[i % 5];
+    out += i % 7 ? " " : "\x7F\x1B[D\x1B[C\r";
+  }
+  return out;
+}
+
+std::string MouseDragStream() {
+  std::string out = "\x1B[<0;10;10M";
+  for (int i = 0; i < 1000; ++i) {
+    out += "\x1B[<32;" + std::to_string(10 + i % 200) + ";" +
+           std::to_string(10 + i % 50) + "M";
+  }
+  out += "\x1B[<0;210;60m";
+  return out;
+}
+
+std::string PasteStream() {
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += "Line " + std::to_string(i) + " of the pasted text.\n";
+  }
+  return "\x1B[200~" + text + "\x1B[201~";
+}
+
+}  // namespace
+
+// Feed a stream to the parser, in chunks of |state.range(1)| bytes, like
+// reads from the terminal would.
+static void BenchmarkTerminalInputParser(benchmark::State& state) {
+  std::string stream;
+  switch (state.range(0)) {
+    case 0:
+      stream = TypingStream();
+      break;
+    case 1:
+      stream = MouseDragStream();
+      break;
+    default:
+      stream = PasteStream();
+      break;
+  }
+  const size_t chunk = state.range(1);
+
+  int64_t events = 0;
+  for (auto _ : state) {
+    TerminalInputParser parser([&](Event) { ++events; });
+    for (size_t i = 0; i < stream.size(); i += chunk) {
+      parser.Add(std::string_view(stream).substr(i, chunk));
+    }
+  }
+  benchmark::DoNotOptimize(events);
+  state.SetBytesProcessed(int64_t(state.iterations()) * stream.size());
+}
+BENCHMARK(BenchmarkTerminalInputParser)
+    ->ArgsProduct({{0, 1, 2}, {1, 4096}});
+
+}  // namespace ftxui
+// NOLINTEND
@@ -120,7 +120,7 @@ Element ComponentBase::Render() {
 
     void SetBox(Box box) override {
       Node::SetBox(box);
-      children_[0]->SetBox(box);
+      children_[0]->CachedSetBox(box);
     }
 
     void ComputeRequirement() override {
@@ -1,9 +1,10 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <map>  // for map
-#include <string>
-#include <utility>  // for move
+#include <map>          // for map
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for move
 
 #include "ftxui/component/event.hpp"
 #include "ftxui/component/mouse.hpp"  // for Mouse
@@ -58,6 +59,34 @@ Event Event::Mouse(std::string input, struct Mouse mouse) {
   return event;
 }
 
+namespace {
+// Bracketed paste: the terminal surrounds the pasted text with these.
+constexpr std::string_view paste_begin = "\x1B[200~";
+constexpr std::string_view paste_end = "\x1B[201~";
+}  // namespace
+
+/// @brief An event corresponding to some text pasted by the user, at once.
+/// @param text The text pasted.
+// static
+Event Event::Paste(std::string text) {
+  Event event;
+  event.input_.reserve(paste_begin.size() + text.size() + paste_end.size());
+  event.input_ += paste_begin;
+  event.input_ += text;
+  event.input_ += paste_end;
+  event.type_ = Type::Paste;
+  return event;
+}
+
+/// @brief The text pasted, for a paste event.
+std::string Event::paste() const {
+  if (!is_paste()) {
+    return "";
+  }
+  return input_.substr(paste_begin.size(),
+                       input_.size() - paste_begin.size() - paste_end.size());
+}
+
 /// @brief An event corresponding to a terminal DCS (Device Control String).
 // static
 Event Event::CursorShape(std::string input, int shape) {
@@ -261,6 +290,8 @@ std::string Event::DebugString() const {
       out += "})";
       return out;
     }
+    case Type::Paste:
+      return "Event::Paste(\"" + paste() + "\")";
     case Type::CursorShape:
       return "Event::CursorShape(" + input_ + ", " +
              std::to_string(data_.cursor_shape) + ")";
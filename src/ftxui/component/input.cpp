@@ -3,7 +3,7 @@
 // the LICENSE file.
 #include <algorithm>   // for max, min
 #include <cstddef>     // for size_t
-#include <cstdint>     // for uint32_t
+#include <cstdint>     // for uint32_t, uint8_t
 #include <functional>  // for function
 #include <sstream>     // for basic_istream, stringstream
 #include <string>      // for string, basic_string, operator==, getline
@@ -363,9 +363,53 @@ class InputBase : public ComponentBase, public InputOption {
     return true;
   }
 
+  // Insert the pasted text at once. The new lines are normalized, or removed
+  // when not multiline. The other control characters are removed. In overtype
+  // mode, the text replaces the same number of glyphs, as if it was typed.
+  bool HandlePaste(const std::string& text) {
+    std::string inserted;
+    inserted.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+      char c = text[i];
+      if (c == '\r') {
+        if (i + 1 < text.size() && text[i + 1] == '\n') {
+          continue;
+        }
+        c = '\n';
+      }
+      if (c == '\n' ? !multiline() : (uint8_t(c) < 32 || c == 127)) {
+        continue;
+      }
+      inserted += c;
+    }
+    if (inserted.empty()) {
+      return true;
+    }
+    if (!insert()) {
+      // Like typing, every glyph replaces the next one, up to the end of line.
+      size_t end = cursor_position();
+      for (size_t glyph = 0; glyph < inserted.size();
+           glyph = GlyphNext(inserted, glyph)) {
+        if (end == content->size() || content()[end] == '\n') {
+          break;
+        }
+        end = GlyphNext(content(), end);
+      }
+      content->erase(cursor_position(), end - cursor_position());
+    }
+    content->insert(cursor_position(), inserted);
+    cursor_position() += static_cast<int>(inserted.size());
+    on_change();
+    return true;
+  }
+
   bool OnEvent(Event event) override {
     cursor_position() = util::clamp(cursor_position(), 0, (int)content->size());
 
+    if (event.is_paste()) {
+      return HandlePaste(event.paste());
+    }
+
     if (event == Event::Return) {
       return HandleReturn();
     }
@@ -26,6 +26,63 @@ TEST(InputTest, Init) {
   EXPECT_EQ(cursor_position, 0);
 }
 
+TEST(InputTest, Paste) {
+  std::string content = "ad";
+  int cursor_position = 1;
+  int on_change = 0;
+  int on_enter = 0;
+  Component input = Input(&content, {
+                                        .on_change = [&] { ++on_change; },
+                                        .on_enter = [&] { ++on_enter; },
+                                        .cursor_position = &cursor_position,
+                                    });
+
+  EXPECT_TRUE(input->OnEvent(Event::Paste("b\r\n\tc\rc")));
+  EXPECT_EQ(content, "ab\nc\ncd");
+  EXPECT_EQ(cursor_position, 6);
+  EXPECT_EQ(on_change, 1);
+  EXPECT_EQ(on_enter, 0);
+}
+
+TEST(InputTest, PasteNotMultiline) {
+  std::string content;
+  int on_enter = 0;
+  Component input = Input(&content, {
+                                        .multiline = false,
+                                        .on_enter = [&] { ++on_enter; },
+                                    });
+
+  EXPECT_TRUE(input->OnEvent(Event::Paste("ab\ncd\n")));
+  EXPECT_EQ(content, "abcd");
+  EXPECT_EQ(on_enter, 0);
+}
+
+// In overtype mode, pasting replaces the same text as typing would.
+TEST(InputTest, PasteOvertype) {
+  const std::string initial = "12345\n6789";
+  const std::string pasted = "ab测\ncd";
+  for (const bool paste : {true, false}) {
+    std::string content = initial;
+    int cursor_position = 1;
+    Component input = Input(&content, {
+                                          .insert = false,
+                                          .cursor_position = &cursor_position,
+                                      });
+    if (paste) {
+      input->OnEvent(Event::Paste(pasted));
+    } else {
+      for (const char* c : {"a", "b", "测"}) {
+        input->OnEvent(Event::Character(c));
+      }
+      input->OnEvent(Event::Return);
+      input->OnEvent(Event::Character("c"));
+      input->OnEvent(Event::Character("d"));
+    }
+    EXPECT_EQ(content, "1ab测\ncd\n6789");
+    EXPECT_EQ(cursor_position, 9);
+  }
+}
+
 TEST(InputTest, Type) {
   std::string content;
   int cursor_position = 0;
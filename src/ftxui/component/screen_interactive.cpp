@@ -5,6 +5,7 @@
 #include <algorithm>  // for copy, max, min
 #include <array>      // for array
 #include <atomic>
+#include <charconv>  // for to_chars
 #include <chrono>  // for operator-, milliseconds, operator>=, duration, common_type<>::type, time_point
 #include <csignal>  // for signal, SIGTSTP, SIGABRT, SIGWINCH, raise, SIGFPE, SIGILL, SIGINT, SIGSEGV, SIGTERM, __sighandler_t, size_t
 #include <cstdint>
@@ -15,8 +16,10 @@
 #include <initializer_list>  // for initializer_list
 #include <iostream>  // for cout, ostream, operator<<, basic_ostream, endl, flush
 #include <memory>
-#include <stack>  // for stack
+#include <optional>  // for optional
+#include <stack>     // for stack
 #include <string>
+#include <string_view>  // for string_view
 #include <thread>   // for thread, sleep_for
 #include <tuple>    // for _Swallow_assign, ignore
 #include <utility>  // for move, swap
@@ -27,8 +30,10 @@
 #include "ftxui/component/component_base.hpp"  // for ComponentBase
 #include "ftxui/component/event.hpp"           // for Event
 #include "ftxui/component/loop.hpp"            // for Loop
+#include "ftxui/component/mouse.hpp"           // for Mouse
 #include "ftxui/component/task_runner.hpp"
 #include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
+#include "ftxui/dom/arena.hpp"                        // for Arena
 #include "ftxui/dom/node.hpp"                         // for Node, Render
 #include "ftxui/screen/terminal.hpp"                  // for Dimensions, Size
 #include "ftxui/screen/util.hpp"                      // for util::clamp
@@ -65,12 +70,89 @@ struct ScreenInteractive::Internal {
 
   task::TaskRunner task_runner;
 
-  // The last time a character was received.
+  // The content currently displayed by the terminal. Used to only print the
+  // cells modified since the previous frame.
+  Screen front_buffer{0, 0};
+
+  // The serialized frame. Kept across frames to reuse its capacity.
+  std::string output;
+
+  // The memory of the elements rendered in a frame, when enabled with
+  // UseFrameArena().
+  Arena frame_arena;
+
+  // The events parsed from the terminal input, not posted yet.
+  std::vector<Event> terminal_events;
+
+  // The last time a character was received, advanced by the time reported to
+  // the terminal input parser since then.
   std::chrono::time_point<std::chrono::steady_clock> last_char_time =
       std::chrono::steady_clock::now();
 
+  // The time the next delayed task is due, if any.
+  std::optional<std::chrono::steady_clock::time_point> next_task_time;
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  // Self-pipe used to wake up the loop while it waits for events. Writing to
+  // it is async-signal-safe, and can be done from any thread.
+  std::array<int, 2> wake_pipe = {-1, -1};
+
+  // Whether a byte is already waiting in `wake_pipe`. Avoid filling it.
+  std::atomic<bool> wake_pending{false};
+
+  // Whether stdin reached end-of-file. It is not waited on anymore.
+  bool stdin_closed = false;
+#endif
+
   explicit Internal(std::function<void(Event)> out)
-      : terminal_input_parser(std::move(out)) {}
+      : terminal_input_parser(std::move(out)) {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    if (pipe(wake_pipe.data()) != 0) {
+      wake_pipe = {-1, -1};
+      return;
+    }
+    for (const int fd : wake_pipe) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);  // NOLINT
+      fcntl(fd, F_SETFD, FD_CLOEXEC);                        // NOLINT
+    }
+#endif
+  }
+
+  ~Internal() {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    for (const int fd : wake_pipe) {
+      if (fd != -1) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  Internal(const Internal&) = delete;
+  Internal(Internal&&) = delete;
+  Internal& operator=(const Internal&) = delete;
+  Internal& operator=(Internal&&) = delete;
+
+  // Report to the terminal input parser the milliseconds elapsed since the
+  // previous report, or the last character. The remainder is kept for the next
+  // report, so that frequent wake ups still add up.
+  void TimeoutInput() {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - last_char_time);
+    last_char_time += elapsed;
+    terminal_input_parser.Timeout(static_cast<int>(elapsed.count()));
+  }
+
+  // Wake up the loop, if it is waiting for events.
+  void Wake() {
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    if (wake_pending.exchange(true)) {
+      return;
+    }
+    const char byte = 0;
+    std::ignore = write(wake_pipe[1], &byte, 1);
+#endif
+  }
 };
 
 namespace animation {
@@ -91,9 +173,57 @@ void Flush() {
   std::cout << '\0' << std::flush;
 }
 
+// Write `output` to the terminal and flush it. On POSIX, this is done using
+// a single write(2) call, bypassing the stdout buffering. Return false if the
+// output couldn't be fully written.
+bool WriteAndFlush(std::string& output) {
+  // Emscripten doesn't implement flush. We interpret zero as flush.
+  output += '\0';
+#if defined(_WIN32) || defined(__EMSCRIPTEN__)
+  std::cout.write(output.data(), std::streamsize(output.size()));
+  std::cout << std::flush;
+  return !std::cout.fail();
+#else
+  // Write whatever is pending in stdout first, to preserve the order.
+  std::cout << std::flush;
+  std::ignore = std::fflush(stdout);
+
+  const char* data = output.data();
+  size_t size = output.size();
+  while (size != 0) {
+    const ssize_t written = write(STDOUT_FILENO, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Non-blocking stdout: wait for the terminal to accept more output.
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        fd_set fds;
+        FD_ZERO(&fds);                // NOLINT
+        FD_SET(STDOUT_FILENO, &fds);  // NOLINT
+        if (select(STDOUT_FILENO + 1, nullptr, &fds, nullptr, nullptr) >= 0 ||
+            errno == EINTR) {
+          continue;
+        }
+      }
+      return false;
+    }
+    data += written;
+    size -= size_t(written);
+  }
+  return true;
+#endif
+}
+
+// Append the decimal representation of a positive number.
+void AppendNumber(std::string& out, int value) {
+  std::array<char, 12> buffer{};
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  out.append(buffer.data(), result.ptr);
+}
+
 constexpr int timeout_milliseconds = 20;
-[[maybe_unused]] constexpr int timeout_microseconds =
-    timeout_milliseconds * 1000;
 #if defined(_WIN32)
 
 #elif defined(__EMSCRIPTEN__)
@@ -121,6 +251,9 @@ int CheckStdinReady() {
   return FD_ISSET(STDIN_FILENO, &fds);                    // NOLINT
 }
 
+// The write end of the active screen's wake pipe, used by signal handlers.
+std::atomic<int> g_wake_fd = -1;  // NOLINT
+
 #endif
 
 std::stack<Closure> on_exit_functions;  // NOLINT
@@ -162,6 +295,15 @@ void RecordSignal(int signal) {
     default:
       break;
   }
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  // Wake up the loop, so that the signal is handled without delay.
+  const int wake_fd = g_wake_fd;
+  if (wake_fd != -1) {
+    const char byte = 0;
+    std::ignore = write(wake_fd, &byte, 1);
+  }
+#endif
 }
 
 void ExecuteSignalHandlers() {
@@ -218,6 +360,7 @@ enum class DECMode : std::uint16_t {
   kMouseUrxvtMode = 1015,
   kMouseSgrPixelsMode = 1016,
   kAlternateScreen = 1049,
+  kBracketedPaste = 2004,
 };
 
 // Device Status Report (DSR) {
@@ -267,6 +410,19 @@ class CapturedMouseImpl : public CapturedMouseInterface {
   std::function<void(void)> callback_;
 };
 
+// Whether |a| can be dropped in favor of the more recent |b|: both are mouse
+// motions, and no button or modifier changed in between.
+bool IsSameMouseMotion(Event& a, Event& b) {
+  if (!a.is_mouse() || !b.is_mouse()) {
+    return false;
+  }
+  const Mouse& m = a.mouse();
+  const Mouse& n = b.mouse();
+  return m.motion == Mouse::Moved && n.motion == Mouse::Moved &&
+         m.button == n.button && m.shift == n.shift && m.meta == n.meta &&
+         m.control == n.control;
+}
+
 }  // namespace
 
 ScreenInteractive::ScreenInteractive(Dimension dimension,
@@ -276,8 +432,9 @@ ScreenInteractive::ScreenInteractive(Dimension dimension,
     : Screen(dimx, dimy),
       dimension_(dimension),
       use_alternative_screen_(use_alternative_screen) {
-  internal_ = std::make_unique<Internal>(
-      [&](Event event) { PostEvent(std::move(event)); });
+  internal_ = std::make_unique<Internal>([&](Event event) {
+    internal_->terminal_events.push_back(std::move(event));
+  });
 }
 
 // static
@@ -372,12 +529,46 @@ void ScreenInteractive::TrackMouse(bool enable) {
   track_mouse_ = enable;
 }
 
+/// @brief Allocate the elements of every frame from an arena, instead of the
+/// heap. The memory is reused by the next frames.
+/// @param enable Whether to use the frame arena.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.UseFrameArena();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::UseFrameArena(bool enable) {
+  use_frame_arena_ = enable;
+}
+
+/// @brief Merge the consecutive mouse motions received from the terminal into
+/// the latest one, before dispatching them to the component. Only the motions
+/// keeping the same buttons and modifiers are merged. Enabled by default.
+/// @param enable Whether to merge the mouse motions.
+/// @see DroppedMouseEvents
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// // Receive every position of the mouse, e.g. to draw the path of a drag.
+/// screen.CoalesceMouseMotion(false);
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::CoalesceMouseMotion(bool enable) {
+  coalesce_mouse_motion_ = enable;
+}
+
 /// @brief Add a task to the main loop.
 /// It will be executed later, after every other scheduled tasks.
 void ScreenInteractive::Post(Task task) {
   internal_->task_runner.PostTask([this, task = std::move(task)]() mutable {
     HandleTask(component_, task);
   });
+  internal_->Wake();
 }
 
 /// @brief Add an event to the main loop.
@@ -386,6 +577,35 @@ void ScreenInteractive::PostEvent(Event event) {
   Post(event);
 }
 
+/// @brief Request a new frame to be drawn, without dispatching any event to
+/// the component.
+///
+/// This is thread-safe. It is meant to be called by background threads
+/// updating the application state. Any number of requests made before the next
+/// frame is drawn are merged into a single one, so the work done is bounded by
+/// the frame rate instead of the number of requests.
+/// @see MergedRedrawRequests
+void ScreenInteractive::RequestRedraw() {
+  if (redraw_requested_.exchange(true)) {
+    merged_redraw_requests_++;
+    return;
+  }
+  Post([this] { frame_valid_ = false; });
+}
+
+/// @brief Return the number of calls to RequestRedraw() merged into a previous
+/// pending one.
+std::uint64_t ScreenInteractive::MergedRedrawRequests() const {
+  return merged_redraw_requests_;
+}
+
+/// @brief Return the number of mouse motion events dropped, because a more
+/// recent one was received before they were dispatched.
+/// @see CoalesceMouseMotion
+std::uint64_t ScreenInteractive::DroppedMouseEvents() const {
+  return dropped_mouse_events_;
+}
+
 /// @brief Add a task to draw the screen one more time, until all the animations
 /// are done.
 void ScreenInteractive::RequestAnimationFrame() {
@@ -398,6 +618,7 @@ void ScreenInteractive::RequestAnimationFrame() {
   if (now - previous_animation_time_ >= time_histeresis) {
     previous_animation_time_ = now;
   }
+  PostAnimationTask();
 }
 
 /// @brief Try to get the unique lock about behing able to capture the mouse.
@@ -520,6 +741,9 @@ ScreenInteractive* ScreenInteractive::Active() {
 void ScreenInteractive::Install() {
   frame_valid_ = false;
 
+  // The terminal content isn't known anymore. Force a full repaint.
+  internal_->front_buffer = Screen(0, 0);
+
   // Flush the buffer for stdout to ensure whatever the user has printed before
   // is fully applied before we start modifying the terminal configuration. This
   // is important, because we are using two different channels (stdout vs
@@ -654,13 +878,23 @@ void ScreenInteractive::Install() {
     enable({DECMode::kMouseSgrExtMode});
   }
 
+  // Receive the pasted text as a single event, instead of one per character.
+  enable({DECMode::kBracketedPaste});
+
   // After installing the new configuration, flush it to the terminal to
   // ensure it is fully applied:
   Flush();
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  // Let the signal handlers wake up the loop.
+  g_wake_fd = internal_->wake_pipe[1];
+  on_exit_functions.emplace([] { g_wake_fd = -1; });
+#endif
+
   quit_ = false;
 
-  PostAnimationTask();
+  // Draw the initial frame.
+  Post(AnimationTask());
 }
 
 // private
@@ -670,28 +904,90 @@ void ScreenInteractive::Uninstall() {
 }
 
 // private
-// NOLINTNEXTLINE
 void ScreenInteractive::RunOnceBlocking(Component component) {
-  // Set FPS to 60 at most.
-  const auto time_per_frame = std::chrono::microseconds(16666);  // 1s / 60fps
-
-  auto time = std::chrono::steady_clock::now();
-  size_t executed_task = internal_->task_runner.ExecutedTasks();
+  const size_t executed_task = internal_->task_runner.ExecutedTasks();
 
   // Wait for at least one task to execute.
-  while (executed_task == internal_->task_runner.ExecutedTasks() &&
-         !HasQuitted()) {
+  while (true) {
     RunOnce(component);
+    if (executed_task != internal_->task_runner.ExecutedTasks() ||
+        HasQuitted()) {
+      return;
+    }
+    WaitForEvents();
+  }
+}
+
+// private
+// Block until the loop might have something to do: terminal input, a posted
+// task, a signal, or a delayed task becoming due.
+void ScreenInteractive::WaitForEvents() {
+  using Clock = std::chrono::steady_clock;
+  std::optional<Clock::duration> timeout;
+  if (internal_->next_task_time) {
+    timeout = std::max(Clock::duration::zero(),
+                       internal_->next_task_time.value() - Clock::now());
+  }
+
+  if (internal_->task_runner.HasImmediateTasks()) {
+    timeout = Clock::duration::zero();
+  }
+
+  // An incomplete escape sequence is flushed after a timeout elapses.
+  if (internal_->terminal_input_parser.HasPendingInput()) {
+    const auto parser_timeout = std::chrono::milliseconds(timeout_milliseconds);
+    timeout = timeout ? std::min<Clock::duration>(*timeout, parser_timeout)
+                      : parser_timeout;
+  }
+
+  const Clock::duration time_per_frame = std::chrono::microseconds(16666);
+#if defined(_WIN32) || defined(__EMSCRIPTEN__)
+  // The input isn't waitable here. Poll it at 60 fps at most.
+  std::this_thread::sleep_for(timeout ? std::min(*timeout, time_per_frame)
+                                      : time_per_frame);
+#else
+  const int wake_fd = internal_->wake_pipe[0];
+
+  // Without the wake pipe, the tasks posted from other threads can't interrupt
+  // the wait. Poll them at 60 fps at most.
+  if (wake_fd == -1) {
+    timeout = timeout ? std::min(*timeout, time_per_frame) : time_per_frame;
+  }
+
+  timeval tv = {0, 0};  // NOLINT
+  timeval* tv_ptr = nullptr;
+  if (timeout) {
+    const auto us =
+        std::chrono::duration_cast<std::chrono::microseconds>(*timeout);
+    tv.tv_sec = static_cast<time_t>(us.count() / 1000000);
+    tv.tv_usec = static_cast<suseconds_t>(us.count() % 1000000);
+    tv_ptr = &tv;
+  }
 
-    const auto now = std::chrono::steady_clock::now();
-    const auto delta = now - time;
-    time = now;
+  fd_set fds;
+  FD_ZERO(&fds);  // NOLINT
+  int max_fd = -1;
+  if (!internal_->stdin_closed) {
+    FD_SET(STDIN_FILENO, &fds);  // NOLINT
+    max_fd = STDIN_FILENO;
+  }
+  if (wake_fd != -1) {
+    FD_SET(wake_fd, &fds);  // NOLINT
+    max_fd = std::max(max_fd, wake_fd);
+  }
 
-    if (delta < time_per_frame) {
-      const auto sleep_duration = time_per_frame - delta;
-      std::this_thread::sleep_for(sleep_duration);
+  if (select(max_fd + 1, &fds, nullptr, nullptr, tv_ptr) <= 0) {
+    return;
+  }
+
+  if (wake_fd != -1 && FD_ISSET(wake_fd, &fds)) {  // NOLINT
+    // Clear the flag first, so that a concurrent Wake() is never lost.
+    internal_->wake_pending = false;
+    std::array<char, 64> buffer{};
+    while (read(wake_fd, buffer.data(), buffer.size()) > 0) {
     }
   }
+#endif
 }
 
 // private
@@ -699,10 +995,16 @@ void ScreenInteractive::RunOnce(Component component) {
   AutoReset set_component(&component_, component);
   ExecuteSignalHandlers();
   FetchTerminalEvents();
+  PostTerminalEvents();
 
   // Execute the pending tasks from the queue.
   const size_t executed_task = internal_->task_runner.ExecutedTasks();
-  internal_->task_runner.RunUntilIdle();
+  const auto next_task_delay = internal_->task_runner.RunUntilIdle();
+  internal_->next_task_time.reset();
+  if (next_task_delay) {
+    internal_->next_task_time =
+        std::chrono::steady_clock::now() + next_task_delay.value();
+  }
   // If no executed task, we can return early without redrawing the screen.
   if (executed_task == internal_->task_runner.ExecutedTasks()) {
     return;
@@ -751,6 +1053,21 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
 
       bool handled = component->OnEvent(arg);
 
+      // The components unaware of paste events receive the pasted text as if
+      // it was typed. A paste can't be nested, and the incomplete sequences
+      // at the end of the text are flushed.
+      if (!handled && arg.is_paste()) {
+        TerminalInputParser parser(
+            [&](Event event) {
+              event.screen_ = this;
+              handled |= component->OnEvent(event);
+            },
+            /*bracketed_paste=*/false);
+        parser.Add(arg.paste());
+        const int longer_than_any_sequence_timeout = 1000;
+        parser.Timeout(longer_than_any_sequence_timeout);
+      }
+
       handled = HandleSelection(handled, arg);
 
       if (arg == Event::CtrlC && (!handled || force_handle_ctrl_c_)) {
@@ -853,6 +1170,17 @@ void ScreenInteractive::Draw(Component component) {
   if (frame_valid_) {
     return;
   }
+
+  // The frame drawn below satisfies every redraw request made until now.
+  redraw_requested_ = false;
+
+  // The elements of the previous frame were released. Reuse their memory.
+  if (use_frame_arena_) {
+    internal_->frame_arena.Reset();
+  }
+  const Arena::Scope arena_scope(
+      use_frame_arena_ ? &internal_->frame_arena : Arena::Current());
+
   auto document = component->Render();
   int dimx = 0;
   int dimy = 0;
@@ -878,21 +1206,26 @@ void ScreenInteractive::Draw(Component component) {
   }
 
   const bool resized = frame_count_ == 0 || (dimx != dimx_) || (dimy != dimy_);
-  ResetCursorPosition();
-  std::cout << ResetPosition(/*clear=*/resized);
+
+  // The whole frame is serialized into a reused buffer, and written at once.
+  std::string& output = internal_->output;
+  output.clear();
+  output += reset_cursor_position;
+  reset_cursor_position.clear();
+  ResetPosition(output, /*clear=*/resized);
 
   // If the terminal width decrease, the terminal emulator will start wrapping
   // lines and make the display dirty. We should clear it completely.
   if ((dimx < dimx_) && !use_alternative_screen_) {
-    std::cout << "\033[J";  // clear terminal output
-    std::cout << "\033[H";  // move cursor to home position
+    output += "\033[J";  // clear terminal output
+    output += "\033[H";  // move cursor to home position
   }
 
   // Resize the screen if needed.
   if (resized) {
     dimx_ = dimx;
     dimy_ = dimy;
-    pixels_ = std::vector<std::vector<Pixel>>(dimy, std::vector<Pixel>(dimx));
+    pixels_ = std::vector<Pixel>(dimx * dimy);
     cursor_.x = dimx_ - 1;
     cursor_.y = dimy_ - 1;
   }
@@ -910,14 +1243,14 @@ void ScreenInteractive::Draw(Component component) {
   static int i = -3;
   ++i;
   if (!use_alternative_screen_ && (i % 150 == 0)) {  // NOLINT
-    std::cout << DeviceStatusReport(DSRMode::kCursor);
+    output += DeviceStatusReport(DSRMode::kCursor);
   }
 #else
   static int i = -3;
   ++i;
   if (!use_alternative_screen_ &&
       (previous_frame_resized_ || i % 40 == 0)) {  // NOLINT
-    std::cout << DeviceStatusReport(DSRMode::kCursor);
+    output += DeviceStatusReport(DSRMode::kCursor);
   }
 #endif
   previous_frame_resized_ = resized;
@@ -938,26 +1271,43 @@ void ScreenInteractive::Draw(Component component) {
     reset_cursor_position.clear();
 
     if (dy != 0) {
-      set_cursor_position += "\x1B[" + std::to_string(dy) + "A";
-      reset_cursor_position += "\x1B[" + std::to_string(dy) + "B";
+      set_cursor_position += "\x1B[";
+      AppendNumber(set_cursor_position, dy);
+      set_cursor_position += "A";
+      reset_cursor_position += "\x1B[";
+      AppendNumber(reset_cursor_position, dy);
+      reset_cursor_position += "B";
     }
 
     if (dx != 0) {
-      set_cursor_position += "\x1B[" + std::to_string(dx) + "D";
-      reset_cursor_position += "\x1B[" + std::to_string(dx) + "C";
+      set_cursor_position += "\x1B[";
+      AppendNumber(set_cursor_position, dx);
+      set_cursor_position += "D";
+      reset_cursor_position += "\x1B[";
+      AppendNumber(reset_cursor_position, dx);
+      reset_cursor_position += "C";
     }
 
     if (cursor_.shape == Cursor::Hidden) {
       set_cursor_position += "\033[?25l";
     } else {
       set_cursor_position += "\033[?25h";
-      set_cursor_position +=
-          "\033[" + std::to_string(int(cursor_.shape)) + " q";
+      set_cursor_position += "\033[";
+      AppendNumber(set_cursor_position, int(cursor_.shape));
+      set_cursor_position += " q";
     }
   }
 
-  std::cout << ToString() << set_cursor_position;
-  Flush();
+  ToString(internal_->front_buffer, output);
+  output += set_cursor_position;
+  if (WriteAndFlush(output)) {
+    // Keep this frame as the terminal content, and draw the next one over the
+    // pixels of the previous one.
+    SwapPixels(internal_->front_buffer);
+  } else {
+    // The terminal content is unknown. Repaint everything on the next frame.
+    internal_->front_buffer = Screen(0, 0);
+  }
   Clear();
   frame_valid_ = true;
   frame_count_++;
@@ -1040,11 +1390,7 @@ void ScreenInteractive::FetchTerminalEvents() {
 
   auto records = get_input_records();
   if (records.size() == 0) {
-    const auto timeout =
-        std::chrono::steady_clock::now() - internal_->last_char_time;
-    const size_t timeout_microseconds =
-        std::chrono::duration_cast<std::chrono::microseconds>(timeout).count();
-    internal_->terminal_input_parser.Timeout(timeout_microseconds);
+    internal_->TimeoutInput();
     return;
   }
   internal_->last_char_time = std::chrono::steady_clock::now();
@@ -1062,9 +1408,7 @@ void ScreenInteractive::FetchTerminalEvents() {
         }
         std::wstring wstring;
         wstring += key_event.uChar.UnicodeChar;
-        for (auto it : to_string(wstring)) {
-          internal_->terminal_input_parser.Add(it);
-        }
+        internal_->terminal_input_parser.Add(to_string(wstring));
       } break;
       case WINDOW_BUFFER_SIZE_EVENT:
         Post(Event::Special({0}));
@@ -1079,51 +1423,70 @@ void ScreenInteractive::FetchTerminalEvents() {
 #elif defined(__EMSCRIPTEN__)
   // Read chars from the terminal.
   // We configured it to be non blocking.
-  std::array<char, 128> out{};
+  std::array<char, 4096> out{};
   size_t l = read(STDIN_FILENO, out.data(), out.size());
   if (l == 0) {
-    const auto timeout =
-        std::chrono::steady_clock::now() - internal_->last_char_time;
-    const size_t timeout_microseconds =
-        std::chrono::duration_cast<std::chrono::microseconds>(timeout).count();
-    internal_->terminal_input_parser.Timeout(timeout_microseconds);
+    internal_->TimeoutInput();
     return;
   }
   internal_->last_char_time = std::chrono::steady_clock::now();
 
   // Convert the chars to events.
-  for (size_t i = 0; i < l; ++i) {
-    internal_->terminal_input_parser.Add(out[i]);
-  }
+  internal_->terminal_input_parser.Add(std::string_view(out.data(), l));
 #else  // POSIX (Linux & Mac)
   if (!CheckStdinReady()) {
-    const auto timeout =
-        std::chrono::steady_clock::now() - internal_->last_char_time;
-    const size_t timeout_ms =
-        std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
-    internal_->terminal_input_parser.Timeout(timeout_ms);
+    internal_->TimeoutInput();
     return;
   }
   internal_->last_char_time = std::chrono::steady_clock::now();
 
   // Read chars from the terminal.
-  std::array<char, 128> out{};
-  size_t l = read(fileno(stdin), out.data(), out.size());
+  std::array<char, 4096> out{};
+  const ssize_t l = read(fileno(stdin), out.data(), out.size());
+  if (l == 0) {
+    // stdin is ready, but empty: it reached end-of-file.
+    internal_->stdin_closed = true;
+    return;
+  }
 
   // Convert the chars to events.
-  for (size_t i = 0; i < l; ++i) {
-    internal_->terminal_input_parser.Add(out[i]);
+  if (l > 0) {
+    internal_->terminal_input_parser.Add(std::string_view(out.data(), l));
   }
 #endif
 }
 
-void ScreenInteractive::PostAnimationTask() {
-  Post(AnimationTask());
+// private
+// Post the events parsed from the last terminal read. When enabled, a mouse
+// motion directly followed by an equivalent one is dropped.
+void ScreenInteractive::PostTerminalEvents() {
+  auto& events = internal_->terminal_events;
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (coalesce_mouse_motion_ && i + 1 < events.size() &&
+        IsSameMouseMotion(events[i], events[i + 1])) {
+      dropped_mouse_events_++;
+      continue;
+    }
+    PostEvent(std::move(events[i]));
+  }
+  events.clear();
+}
 
-  // Repeat the animation task every 15ms. This correspond to a frame rate
-  // of around 66fps.
-  internal_->task_runner.PostDelayedTask([this] { PostAnimationTask(); },
-                                         std::chrono::milliseconds(15));
+void ScreenInteractive::PostAnimationTask() {
+  // Run the animation 15ms after the previous one. This correspond to a frame
+  // rate of around 66fps. Nothing is scheduled while no animation is running.
+  const auto time_per_frame = std::chrono::milliseconds(15);
+  const auto elapsed = animation::Clock::now() - previous_animation_time_;
+  const auto delay =
+      std::max<animation::Duration>(animation::Duration::zero(),
+                                    time_per_frame - elapsed);
+  internal_->task_runner.PostDelayedTask(
+      [this] {
+        Task task = AnimationTask();
+        HandleTask(component_, task);
+      },
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay));
+  internal_->Wake();
 }
 
 bool ScreenInteractive::SelectionData::operator==(
@@ -6,7 +6,8 @@
 #include <ftxui/component/event.hpp>  // for Event, Event::Custom
 #include <tuple>                      // for _Swallow_assign, ignore
 
-#include "ftxui/component/component.hpp"  // for Renderer
+#include "ftxui/component/animation.hpp"  // for RequestAnimationFrame, Params
+#include "ftxui/component/component.hpp"  // for Renderer, Make
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/dom/elements.hpp"  // for text, Element
 
@@ -17,6 +18,8 @@
 #include <cstdio>
 #include <ftxui/component/loop.hpp>
 #include <string>
+#include <vector>
+#include "ftxui/component/mouse.hpp"           // for Mouse
 #endif
 
 namespace ftxui {
@@ -99,6 +102,63 @@ TEST(ScreenInteractive, Signal_SIGFPE) {
   TestSignal(SIGFPE);
 }
 
+// The loop waits for events instead of polling. Animation frames must still
+// be delivered while nothing else happens.
+TEST(ScreenInteractive, AnimationFrames) {
+  class Animated : public ComponentBase {
+   public:
+    explicit Animated(ScreenInteractive* screen) : screen_(screen) {}
+
+    Element OnRender() override {
+      animation::RequestAnimationFrame();
+      return text("");
+    }
+
+    void OnAnimation(animation::Params& /*params*/) override {
+      if (++frames_ == 3) {
+        screen_->Exit();
+      }
+    }
+
+   private:
+    ScreenInteractive* screen_;
+    int frames_ = 0;
+  };
+
+  auto screen = ScreenInteractive::FitComponent();
+  screen.Loop(Make<Animated>(&screen));
+}
+
+TEST(ScreenInteractive, RequestRedrawIsCoalesced) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  int render_count = 0;
+  auto component = Renderer([&] {
+    render_count++;
+    return text("");
+  });
+
+  Loop loop(&screen, component);
+  loop.RunOnce();
+  EXPECT_EQ(render_count, 1);
+
+  for (int i = 0; i < 100; ++i) {
+    screen.RequestRedraw();
+  }
+  loop.RunOnce();
+  EXPECT_EQ(render_count, 2);
+  EXPECT_EQ(screen.MergedRedrawRequests(), 99u);
+
+  // Nothing left to draw.
+  loop.RunOnce();
+  EXPECT_EQ(render_count, 2);
+
+  // A new request after the frame draws a new one.
+  screen.RequestRedraw();
+  loop.RunOnce();
+  EXPECT_EQ(render_count, 3);
+  EXPECT_EQ(screen.MergedRedrawRequests(), 99u);
+}
+
 // Regression test for:
 // https://github.com/ArthurSonzogni/FTXUI/issues/402
 TEST(ScreenInteractive, PostEventToNonActive) {
@@ -180,6 +240,142 @@ TEST(ScreenInteractive, CtrlC_NotForced) {
   ASSERT_GE(ctrl_c_count, 50);
 }
 
+// The components not handling paste events receive the pasted text as typed.
+TEST(ScreenInteractive, PasteFallback) {
+  auto screen = ScreenInteractive::FitComponent();
+  std::vector<Event> received;
+  auto component = Renderer([] { return text(""); });
+  component |= CatchEvent([&](Event event) {
+    if (event == Event::Custom) {
+      screen.Exit();
+      return true;
+    }
+    received.push_back(event);
+    return !event.is_paste();
+  });
+  screen.PostEvent(Event::Paste("a测\n"));
+  screen.PostEvent(Event::Custom);
+  screen.Loop(component);
+
+  ASSERT_EQ(received.size(), 4u);
+  EXPECT_TRUE(received[0].is_paste());
+  EXPECT_EQ(received[1], Event::Character("a"));
+  EXPECT_EQ(received[2], Event::Character("测"));
+  EXPECT_EQ(received[3], Event::Return);
+}
+
+// The pasted text is replayed without starting another paste, and the
+// sequence left incomplete at its end is flushed.
+TEST(ScreenInteractive, PasteFallbackSequences) {
+  auto screen = ScreenInteractive::FitComponent();
+  std::vector<Event> received;
+  auto component = Renderer([] { return text(""); });
+  component |= CatchEvent([&](Event event) {
+    if (event == Event::Custom) {
+      screen.Exit();
+      return true;
+    }
+    received.push_back(event);
+    return !event.is_paste();
+  });
+  screen.PostEvent(Event::Paste("a\x1B[200~b\x1B"));
+  screen.PostEvent(Event::Custom);
+  screen.Loop(component);
+
+  ASSERT_EQ(received.size(), 5u);
+  EXPECT_EQ(received[1], Event::Character("a"));
+  EXPECT_EQ(received[2], Event::Special("\x1B[200~"));
+  EXPECT_EQ(received[3], Event::Character("b"));
+  EXPECT_EQ(received[4], Event::Escape);
+}
+
+#if defined(__unix__)
+namespace {
+
+// Run |screen| on the terminal |input|, and return the mouse events received.
+std::vector<Mouse> ReceivedMouseEvents(ScreenInteractive& screen,
+                                       const std::string& input) {
+  std::array<int, 2> fds{};
+  if (pipe(fds.data()) != 0) {
+    return {};
+  }
+  const int old_stdin = dup(STDIN_FILENO);
+  dup2(fds[0], STDIN_FILENO);
+  close(fds[0]);
+  std::ignore = write(fds[1], input.data(), input.size());
+  close(fds[1]);
+
+  std::vector<Mouse> received;
+  auto component = Renderer([] { return text(""); });
+  component |= CatchEvent([&](Event event) {
+    if (event == Event::Character('q')) {
+      screen.Exit();
+    }
+    if (event.is_mouse()) {
+      received.push_back(event.mouse());
+    }
+    return true;
+  });
+
+  std::string output;
+  {
+    const StdCapture capture(&output);
+    screen.Loop(component);
+  }
+
+  dup2(old_stdin, STDIN_FILENO);
+  close(old_stdin);
+  return received;
+}
+
+std::string MouseDrag() {
+  std::string input;
+  for (int i = 1; i <= 100; ++i) {  // Hover.
+    input += "\x1B[<35;" + std::to_string(i) + ";1M";
+  }
+  input += "\x1B[<0;100;1M";         // Press.
+  for (int i = 1; i <= 10; ++i) {  // Drag.
+    input += "\x1B[<32;100;" + std::to_string(i) + "M";
+  }
+  input += "\x1B[<4;100;10M";  // Press with shift.
+  input += "\x1B[<0;100;10m";  // Release.
+  input += "q";
+  return input;
+}
+
+}  // namespace
+
+TEST(ScreenInteractive, CoalesceMouseMotion) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  const std::vector<Mouse> received = ReceivedMouseEvents(screen, MouseDrag());
+
+  ASSERT_EQ(received.size(), 5u);
+  EXPECT_EQ(received[0].motion, Mouse::Moved);
+  EXPECT_EQ(received[0].button, Mouse::None);
+  EXPECT_EQ(received[1].motion, Mouse::Pressed);
+  EXPECT_EQ(received[2].motion, Mouse::Moved);
+  EXPECT_EQ(received[2].button, Mouse::Left);
+  EXPECT_EQ(received[3].motion, Mouse::Pressed);
+  EXPECT_TRUE(received[3].shift);
+  EXPECT_EQ(received[4].motion, Mouse::Released);
+
+  // The latest position is kept.
+  EXPECT_EQ(received[0].x - received[1].x, 0);
+  EXPECT_EQ(received[2].y - received[1].y, 9);
+
+  EXPECT_EQ(screen.DroppedMouseEvents(), 99u + 9u);
+}
+
+TEST(ScreenInteractive, CoalesceMouseMotionDisabled) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.CoalesceMouseMotion(false);
+  const std::vector<Mouse> received = ReceivedMouseEvents(screen, MouseDrag());
+
+  EXPECT_EQ(received.size(), 113u);
+  EXPECT_EQ(screen.DroppedMouseEvents(), 0u);
+}
+#endif
+
 // Regression test for:
 // https://github.com/ArthurSonzogni/FTXUI/pull/1064/files
 TEST(ScreenInteractive, FixedSizeInitialFrame) {
@@ -206,6 +402,7 @@ TEST(ScreenInteractive, FixedSizeInitialFrame) {
       "\x1B[?1003h"  // Enable mouse motion tracking.
       "\x1B[?1015h"  // Enable mouse wheel tracking.
       "\x1B[?1006h"  // Enable SGR mouse tracking.
+      "\x1B[?2004h"  // Enable bracketed paste.
       "\0"           // Flush stdout.
 
       // Reset the screen.
@@ -227,6 +424,7 @@ TEST(ScreenInteractive, FixedSizeInitialFrame) {
 
       // Uninstall the ScreenInteractive.
       "\x1B[1C"      // Move cursor right one character.
+      "\x1B[?2004l"  // Disable bracketed paste.
       "\x1B[?1006l"  // Disable SGR mouse tracking.
       "\x1B[?1015l"  // Disable mouse wheel tracking.
       "\x1B[?1003l"  // Disable mouse motion tracking.
@@ -242,4 +440,104 @@ TEST(ScreenInteractive, FixedSizeInitialFrame) {
 #endif
 }
 
+// Only the cells modified since the previous frame are printed.
+TEST(ScreenInteractive, FixedSizeDiffFrame) {
+#if defined(__unix__)
+  std::string output;
+  {
+    auto screen = ScreenInteractive::FixedSize(3, 2);
+    std::string content = "ABC";
+    auto component = Renderer([&] { return text(content); });
+
+    Loop loop(&screen, component);
+    loop.RunOnce();
+
+    auto capture = StdCapture(&output);
+    content = "AXC";
+    screen.PostEvent(Event::Custom);
+    loop.RunOnce();
+  }
+  using namespace std::string_view_literals;
+
+  auto expected =
+      // Reset the cursor position.
+      "\x1B[1C"  // Move cursor right one character.
+      "\r"       // Reset cursor position.
+      "\x1B[1A"  // Move cursor up one line.
+
+      // Request the cursor position, following the initial frame.
+      "\x1B[6n"
+
+      // Print the modified cell only.
+      "\x1B[2G"  // Move cursor to the second column.
+      "X"
+
+      // Move the cursor after the last cell.
+      "\x1B[1B"  // Move cursor down one line.
+      "\x1B[4G"  // Move cursor after the last column.
+
+      // Set cursor position.
+      "\x1B[1D"    // Move cursor left one character.
+      "\x1B[?25l"  // Hide cursor.
+
+      // Flush
+      "\0"sv;  // Flush stdout.
+
+  ASSERT_EQ(expected, output.substr(0, expected.size()));
+#endif
+}
+
+// The frames are compared with the previous one, not the first one.
+TEST(ScreenInteractive, FixedSizeDiffFrames) {
+#if defined(__unix__)
+  std::string output;
+  {
+    auto screen = ScreenInteractive::FixedSize(3, 2);
+    std::string content = "ABC";
+    auto component = Renderer([&] { return text(content); });
+
+    Loop loop(&screen, component);
+    loop.RunOnce();
+    content = "AXC";
+    screen.PostEvent(Event::Custom);
+    loop.RunOnce();
+
+    auto capture = StdCapture(&output);
+    content = "AXY";
+    screen.PostEvent(Event::Custom);
+    loop.RunOnce();
+  }
+  using namespace std::string_view_literals;
+
+  // The cursor position is requested periodically. Ignore it.
+  const std::string request = "\x1B[6n";
+  const size_t position = output.find(request);
+  if (position != std::string::npos) {
+    output.erase(position, request.size());
+  }
+
+  auto expected =
+      // Reset the cursor position.
+      "\x1B[1C"  // Move cursor right one character.
+      "\r"       // Reset cursor position.
+      "\x1B[1A"  // Move cursor up one line.
+
+      // Print the modified cell only.
+      "\x1B[3G"  // Move cursor to the third column.
+      "Y"
+
+      // Move the cursor after the last cell.
+      "\x1B[1B"  // Move cursor down one line.
+
+      // Set cursor position.
+      "\x1B[1D"    // Move cursor left one character.
+      "\x1B[?25l"  // Hide cursor.
+
+      // Flush
+      "\0"sv;  // Flush stdout.
+
+  ASSERT_EQ(expected, output.substr(0, expected.size()));
+#endif
+}
+
 }  // namespace ftxui
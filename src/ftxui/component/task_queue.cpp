@@ -5,40 +5,49 @@
 
 namespace ftxui::task {
 
+TaskQueue::TaskQueue() : head_(new Node(nullptr)), tail_(head_.load()) {}
+
+TaskQueue::~TaskQueue() {
+  Task task;
+  while (PopImmediate(task)) {
+  }
+  delete tail_;
+}
+
 auto TaskQueue::PostTask(PendingTask task) -> void {
   if (!task.time) {
-    immediate_tasks_.push(task);
+    PushImmediate(std::move(task.task));
     return;
   }
 
   if (task.time.value() < std::chrono::steady_clock::now()) {
-    immediate_tasks_.push(task);
+    PushImmediate(std::move(task.task));
     return;
   }
 
-  delayed_tasks_.push(task);
+  const std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
+  delayed_tasks_.push(std::move(task));
 }
 
 auto TaskQueue::Get() -> MaybeTask {
   // Attempt to execute a task immediately.
-  if (!immediate_tasks_.empty()) {
-    auto task = immediate_tasks_.front();
-    immediate_tasks_.pop();
-    return task.task;
+  Task task;
+  if (PopImmediate(task)) {
+    return task;
   }
 
+  const std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
+
   // Move all tasks that can be executed to the immediate queue.
   auto now = std::chrono::steady_clock::now();
   while (!delayed_tasks_.empty() && delayed_tasks_.top().time.value() <= now) {
-    immediate_tasks_.push(delayed_tasks_.top());
+    PushImmediate(delayed_tasks_.top().task);
     delayed_tasks_.pop();
   }
 
   // Attempt to execute a task immediately.
-  if (!immediate_tasks_.empty()) {
-    auto task = immediate_tasks_.front();
-    immediate_tasks_.pop();
-    return task.task;
+  if (PopImmediate(task)) {
+    return task;
   }
 
   // If there are no tasks to execute, return the delay until the next task.
@@ -50,4 +59,30 @@ auto TaskQueue::Get() -> MaybeTask {
   return std::monostate{};
 }
 
+bool TaskQueue::HasImmediateTasks() const {
+  return tail_->next.load(std::memory_order_acquire) != nullptr;
+}
+
+// Multi-producer/single-consumer queue, see:
+// https://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue
+auto TaskQueue::PushImmediate(Task task) -> void {
+  Node* node = new Node(std::move(task));
+  Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+  // Between the exchange and the store, the consumer sees the queue as
+  // stopping at `previous`. The new task becomes visible right after.
+  previous->next.store(node, std::memory_order_release);
+}
+
+auto TaskQueue::PopImmediate(Task& task) -> bool {
+  Node* next = tail_->next.load(std::memory_order_acquire);
+  if (!next) {
+    return false;
+  }
+  task = std::move(next->task);
+  next->task = nullptr;
+  delete tail_;
+  tail_ = next;
+  return true;
+}
+
 }  // namespace ftxui::task
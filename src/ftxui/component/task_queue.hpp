@@ -4,6 +4,8 @@
 #ifndef TASK_QUEUE_HPP
 #define TASK_QUEUE_HPP
 
+#include <atomic>
+#include <mutex>
 #include <queue>
 #include <variant>
 
@@ -18,17 +20,44 @@ namespace ftxui::task {
 ///   executed in the order they were scheduled.
 /// - If a task is scheduled to be executed in the past, it is executed
 ///   immediately.
+///
+/// Thread safety: PostTask() can be called concurrently from any thread. Get()
+/// and HasImmediateTasks() must only be called from the thread consuming the
+/// tasks. Immediate tasks go through a lock-free multi-producer/single-consumer
+/// queue. Delayed tasks are protected by a mutex.
 struct TaskQueue {
+  TaskQueue();
+  ~TaskQueue();
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue(TaskQueue&&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+  TaskQueue& operator=(TaskQueue&&) = delete;
+
   auto PostTask(PendingTask task) -> void;
 
   using MaybeTask =
       std::variant<Task, std::chrono::steady_clock::duration, std::monostate>;
   auto Get() -> MaybeTask;
 
-  bool HasImmediateTasks() const { return !immediate_tasks_.empty(); }
+  bool HasImmediateTasks() const;
 
  private:
-  std::queue<PendingTask> immediate_tasks_;
+  // A node of the immediate tasks queue. The queue always contains a node
+  // whose task has already been consumed. The tasks are in the next ones.
+  struct Node {
+    explicit Node(Task t) : task(std::move(t)) {}
+    std::atomic<Node*> next{nullptr};
+    Task task;
+  };
+
+  auto PushImmediate(Task task) -> void;
+  auto PopImmediate(Task& task) -> bool;
+
+  // Producers exchange `head_`, the consumer pops from `tail_`.
+  std::atomic<Node*> head_;
+  Node* tail_;
+
+  std::mutex delayed_tasks_mutex_;
   std::priority_queue<PendingTask> delayed_tasks_;
 };
 
@@ -18,9 +18,11 @@ class TaskRunner {
   static auto Current() -> TaskRunner*;
 
   /// Schedules a task to be executed immediately.
+  /// Thread-safe: can be called from any thread.
   auto PostTask(Task task) -> void;
 
   /// Schedules a task to be executed after a certain duration.
+  /// Thread-safe: can be called from any thread.
   auto PostDelayedTask(Task task, std::chrono::steady_clock::duration duration)
       -> void;
 
@@ -8,7 +8,9 @@
 
 #include <gtest/gtest.h>
 
-#include <thread>  // for sleep_for
+#include <atomic>  // for atomic
+#include <thread>  // for sleep_for, thread
+#include <vector>  // for vector
 #include "ftxui/component/task_runner.hpp"
 
 namespace ftxui::task {
@@ -91,4 +93,48 @@ TEST(TaskTest, RunDelayedTask) {
   EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
 }
 
+// Many threads post tasks concurrently, while the tasks are being executed.
+// Meant to be run under ThreadSanitizer too.
+TEST(TaskTest, PostFromManyThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kTasksPerThread = 5000;
+
+  auto runner = TaskRunner();
+  std::vector<std::vector<int>> values(kThreads);
+  std::atomic<int> started = 0;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      started++;
+      while (started != kThreads) {
+      }
+      for (int i = 0; i < kTasksPerThread; ++i) {
+        if (i % 100 == 0) {
+          runner.PostDelayedTask([] {}, std::chrono::microseconds(i));
+        }
+        runner.PostTask([&values, t, i] { values[t].push_back(i); });
+      }
+    });
+  }
+
+  const size_t expected_tasks =
+      kThreads * (kTasksPerThread + kTasksPerThread / 100);
+  while (runner.ExecutedTasks() != expected_tasks) {
+    runner.RunUntilIdle();
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The tasks posted by a thread are executed in order.
+  for (int t = 0; t < kThreads; ++t) {
+    ASSERT_EQ(values[t].size(), size_t(kTasksPerThread));
+    for (int i = 0; i < kTasksPerThread; ++i) {
+      EXPECT_EQ(values[t][i], i);
+    }
+  }
+}
+
 }  // namespace ftxui::task
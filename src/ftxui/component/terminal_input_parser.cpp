@@ -3,20 +3,25 @@
 // the LICENSE file.
 #include "ftxui/component/terminal_input_parser.hpp"
 
-#include <cstdint>                    // for uint32_t
+#include <algorithm>  // for lower_bound, sort
+#include <array>      // for array
+#include <cstdint>    // for uint32_t
 #include <ftxui/component/mouse.hpp>  // for Mouse, Mouse::Button, Mouse::Motion
-#include <functional>                 // for std::function
-#include <map>
-#include <memory>   // for unique_ptr, allocator
-#include <utility>  // for move
-#include <vector>
+#include <functional>   // for std::function
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <utility>      // for move, pair
+#include <vector>       // for vector
 #include "ftxui/component/event.hpp"  // for Event
-#include "ftxui/component/task.hpp"   // for Task
 
 namespace ftxui {
 
+namespace {
+
+using Uniformization = std::pair<std::string_view, std::string_view>;
+
 // NOLINTNEXTLINE
-const std::map<std::string, std::string> g_uniformize = {
+constexpr Uniformization g_uniformize[] = {
     // Microsoft's terminal uses a different new line character for the return
     // key. This also happens with linux with the `bind` command:
     // See https://github.com/ArthurSonzogni/FTXUI/issues/337
@@ -24,7 +29,7 @@ const std::map<std::string, std::string> g_uniformize = {
     {"\r", "\n"},
 
     // See: https://github.com/ArthurSonzogni/FTXUI/issues/508
-    {std::string({8}), std::string({127})},
+    {"\x08", "\x7F"},
 
     // See: https://github.com/ArthurSonzogni/FTXUI/issues/626
     //
@@ -90,11 +95,52 @@ const std::map<std::string, std::string> g_uniformize = {
     {"\x1B[X", "\x1B[24~"},  // F12
 };
 
-TerminalInputParser::TerminalInputParser(std::function<void(Event)> out)
-    : out_(std::move(out)) {}
+// Replace |sequence| by its uniformized form, if any. The table is sorted once,
+// and searched by bisection.
+void Uniformize(std::string& sequence) {
+  static const auto sorted = [] {
+    std::array<Uniformization, std::size(g_uniformize)> out{};
+    std::copy(std::begin(g_uniformize), std::end(g_uniformize), out.begin());
+    std::sort(out.begin(), out.end());
+    return out;
+  }();
+  const std::string_view key = sequence;
+  auto it = std::lower_bound(
+      sorted.begin(), sorted.end(), key,
+      [](const Uniformization& a, std::string_view b) { return a.first < b; });
+  if (it != sorted.end() && it->first == key) {
+    sequence = it->second;
+  }
+}
+
+constexpr std::string_view kPasteEnd = "\x1B[201~";
+
+// When the end of a paste never comes, the text received is sent anyway after
+// this timeout in milliseconds, or by parts once it exceeds this size.
+constexpr int kPasteTimeout = 1000;
+constexpr size_t kMaxPasteSize = 1 << 22;  // 4MiB
+
+}  // namespace
+
+TerminalInputParser::TerminalInputParser(std::function<void(Event)> out,
+                                         bool bracketed_paste)
+    : out_(std::move(out)), bracketed_paste_(bracketed_paste) {}
 
 void TerminalInputParser::Timeout(int time) {
   timeout_ += time;
+  if (state_ == State::Paste) {
+    if (timeout_ < kPasteTimeout) {
+      return;
+    }
+    timeout_ = 0;
+    state_ = State::Ground;
+    if (!paste_.empty()) {
+      out_(Event::Paste(std::move(paste_)));
+      paste_.clear();
+    }
+    return;
+  }
+
   const int timeout_threshold = 50;
   if (timeout_ < timeout_threshold) {
     return;
@@ -106,22 +152,70 @@ void TerminalInputParser::Timeout(int time) {
 }
 
 void TerminalInputParser::Add(char c) {
-  pending_ += c;
-  timeout_ = 0;
-  position_ = -1;
-  Send(Parse());
+  Add(std::string_view(&c, 1));
 }
 
-unsigned char TerminalInputParser::Current() {
-  return pending_[position_];
+void TerminalInputParser::Add(std::string_view input) {
+  size_t i = 0;
+  while (i < input.size()) {
+    if (state_ == State::Paste) {
+      i += AddPaste(input.substr(i));
+      continue;
+    }
+
+    timeout_ = 0;
+    const auto c = static_cast<unsigned char>(input[i++]);
+
+    // Fast path: printable ASCII characters outside of any sequence.
+    if (state_ == State::Ground && c >= 32 && c < 127) {  // NOLINT
+      out_(Event::Character(static_cast<char>(c)));
+      continue;
+    }
+
+    pending_ += static_cast<char>(c);
+    Send(Parse(c));
+  }
 }
 
-bool TerminalInputParser::Eat() {
-  position_++;
-  return position_ < static_cast<int>(pending_.size());
+// The pasted text is accumulated until the end of the paste, and sent as a
+// single event. Returns the number of bytes of |input| consumed.
+size_t TerminalInputParser::AddPaste(std::string_view input) {
+  timeout_ = 0;
+  const size_t previous = paste_.size();
+  paste_ += input;
+
+  // The terminator can only complete in a chunk containing its last byte. It
+  // might have started in a previous chunk.
+  size_t end = std::string::npos;
+  if (input.find(kPasteEnd.back()) != std::string_view::npos) {
+    const size_t search_from =
+        previous >= kPasteEnd.size() ? previous - kPasteEnd.size() + 1 : 0;
+    end = paste_.find(kPasteEnd, search_from);
+  }
+
+  if (end == std::string::npos) {
+    // Bound the memory used, by sending the text which can't be part of the
+    // terminator.
+    if (paste_.size() > kMaxPasteSize) {
+      const size_t sent = paste_.size() - (kPasteEnd.size() - 1);
+      out_(Event::Paste(paste_.substr(0, sent)));
+      paste_.erase(0, sent);
+    }
+    return input.size();
+  }
+  paste_.resize(end);
+  state_ = State::Ground;
+  out_(Event::Paste(std::move(paste_)));
+  paste_.clear();
+  return end + kPasteEnd.size() - previous;
 }
 
 void TerminalInputParser::Send(TerminalInputParser::Output output) {
+  if (output.type == UNCOMPLETED) {
+    return;
+  }
+  state_ = State::Ground;
+
   switch (output.type) {
     case UNCOMPLETED:
       return;
@@ -135,14 +229,10 @@ void TerminalInputParser::Send(TerminalInputParser::Output output) {
       pending_.clear();
       return;
 
-    case SPECIAL: {
-      auto it = g_uniformize.find(pending_);
-      if (it != g_uniformize.end()) {
-        pending_ = it->second;
-      }
+    case SPECIAL:
+      Uniformize(pending_);
       out_(Event::Special(std::move(pending_)));
       pending_.clear();
-    }
       return;
 
     case MOUSE:
@@ -161,48 +251,88 @@ void TerminalInputParser::Send(TerminalInputParser::Output output) {
       out_(Event::CursorShape(std::move(pending_), output.cursor_shape));
       pending_.clear();
       return;
+
+    case PASTE_BEGIN:
+      pending_.clear();
+      state_ = State::Paste;
+      return;
   }
   // NOT_REACHED().
 }
 
-TerminalInputParser::Output TerminalInputParser::Parse() {
-  if (!Eat()) {
-    return UNCOMPLETED;
+// Consume one byte. |c| was already appended to |pending_|.
+TerminalInputParser::Output TerminalInputParser::Parse(unsigned char c) {
+  switch (state_) {
+    case State::Ground:
+      return ParseGround(c);
+
+    case State::UTF8:
+      return ParseUTF8(c);
+
+    case State::ESC:
+      return ParseESC(c);
+
+    case State::ESCIntermediate:
+      return SPECIAL;
+
+    case State::CSI:
+      return ParseCSI(c);
+
+    // Parse until the string terminator ST: ESC BACKSLASH.
+    case State::DCS:
+    case State::OSC:
+      if (c == '\x1B') {
+        state_ = state_ == State::DCS ? State::DCSEscape : State::OSCEscape;
+      }
+      return UNCOMPLETED;
+
+    case State::DCSEscape:
+      if (c != '\\') {
+        state_ = State::DCS;
+        return UNCOMPLETED;
+      }
+      return ParseDCS();
+
+    case State::OSCEscape:
+      if (c != '\\') {
+        state_ = State::OSC;
+        return UNCOMPLETED;
+      }
+      return SPECIAL;
+
+    case State::Paste:
+      break;
   }
+  return UNCOMPLETED;  // NOT_REACHED().
+}
 
-  if (Current() == '\x1B') {
-    return ParseESC();
+TerminalInputParser::Output TerminalInputParser::ParseGround(unsigned char c) {
+  if (c == '\x1B') {
+    state_ = State::ESC;
+    return UNCOMPLETED;
   }
 
-  if (Current() < 32) {  // C0 NOLINT
+  if (c < 32) {  // C0 NOLINT
     return SPECIAL;
   }
 
-  if (Current() == 127) {  // Delete // NOLINT
+  if (c == 127) {  // Delete // NOLINT
     return SPECIAL;
   }
 
-  return ParseUTF8();
-}
-
-// Code point <-> UTF-8 conversion
-//
-// ┏━━━━━━━━┳━━━━━━━━┳━━━━━━━━┳━━━━━━━━┓
-// ┃Byte 1  ┃Byte 2  ┃Byte 3  ┃Byte 4  ┃
-// ┡━━━━━━━━╇━━━━━━━━╇━━━━━━━━╇━━━━━━━━┩
-// │0xxxxxxx│        │        │        │
-// ├────────┼────────┼────────┼────────┤
-// │110xxxxx│10xxxxxx│        │        │
-// ├────────┼────────┼────────┼────────┤
-// │1110xxxx│10xxxxxx│10xxxxxx│        │
-// ├────────┼────────┼────────┼────────┤
-// │11110xxx│10xxxxxx│10xxxxxx│10xxxxxx│
-// └────────┴────────┴────────┴────────┘
-//
-// Then some sequences are illegal if it exist a shorter representation of the
-// same codepoint.
-TerminalInputParser::Output TerminalInputParser::ParseUTF8() {
-  auto head = Current();
+  // Code point <-> UTF-8 conversion
+  //
+  // ┏━━━━━━━━┳━━━━━━━━┳━━━━━━━━┳━━━━━━━━┓
+  // ┃Byte 1  ┃Byte 2  ┃Byte 3  ┃Byte 4  ┃
+  // ┡━━━━━━━━╇━━━━━━━━╇━━━━━━━━╇━━━━━━━━┩
+  // │0xxxxxxx│        │        │        │
+  // ├────────┼────────┼────────┼────────┤
+  // │110xxxxx│10xxxxxx│        │        │
+  // ├────────┼────────┼────────┼────────┤
+  // │1110xxxx│10xxxxxx│10xxxxxx│        │
+  // ├────────┼────────┼────────┼────────┤
+  // │11110xxx│10xxxxxx│10xxxxxx│10xxxxxx│
+  // └────────┴────────┴────────┴────────┘
   unsigned char selector = 0b1000'0000;  // NOLINT
 
   // The non code-point part of the first byte.
@@ -212,69 +342,80 @@ TerminalInputParser::Output TerminalInputParser::ParseUTF8() {
   unsigned int first_zero = 8;            // NOLINT
   for (unsigned int i = 0; i < 8; ++i) {  // NOLINT
     mask |= selector;
-    if (!(head & selector)) {
+    if (!(c & selector)) {
       first_zero = i;
       break;
     }
     selector >>= 1U;
   }
 
-  // Accumulate the value of the first byte.
-  auto value = uint32_t(head & ~mask);  // NOLINT
-
   // Invalid UTF8, with more than 5 bytes.
   const unsigned int max_utf8_bytes = 5;
   if (first_zero == 1 || first_zero >= max_utf8_bytes) {
     return DROP;
   }
 
-  // Multi byte UTF-8.
-  for (unsigned int i = 2; i <= first_zero; ++i) {
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
+  // Accumulate the value of the first byte.
+  utf8_value_ = uint32_t(c & ~mask);  // NOLINT
+  utf8_remaining_ = first_zero == 0 ? 0 : int(first_zero) - 1;
+  if (utf8_remaining_ == 0) {
+    return CompleteUTF8();
+  }
+  state_ = State::UTF8;
+  return UNCOMPLETED;
+}
 
-    // Invalid continuation byte.
-    head = Current();
-    if ((head & 0b1100'0000) != 0b1000'0000) {  // NOLINT
-      return DROP;
-    }
-    value <<= 6;                  // NOLINT
-    value += head & 0b0011'1111;  // NOLINT
+// Multi byte UTF-8.
+TerminalInputParser::Output TerminalInputParser::ParseUTF8(unsigned char c) {
+  // Invalid continuation byte.
+  if ((c & 0b1100'0000) != 0b1000'0000) {  // NOLINT
+    return DROP;
+  }
+  utf8_value_ <<= 6;              // NOLINT
+  utf8_value_ += c & 0b0011'1111;  // NOLINT
+  if (--utf8_remaining_ != 0) {
+    return UNCOMPLETED;
   }
+  return CompleteUTF8();
+}
 
+// Some sequences are illegal if it exist a shorter representation of the
+// same codepoint.
+TerminalInputParser::Output TerminalInputParser::CompleteUTF8() {
   // Check for overlong UTF8 encoding.
-  int extra_byte = 0;
-  if (value <= 0b000'0000'0111'1111) {                 // NOLINT
-    extra_byte = 0;                                    // NOLINT
-  } else if (value <= 0b000'0111'1111'1111) {          // NOLINT
-    extra_byte = 1;                                    // NOLINT
-  } else if (value <= 0b1111'1111'1111'1111) {         // NOLINT
-    extra_byte = 2;                                    // NOLINT
-  } else if (value <= 0b1'0000'1111'1111'1111'1111) {  // NOLINT
-    extra_byte = 3;                                    // NOLINT
-  } else {                                             // NOLINT
+  size_t extra_byte = 0;
+  if (utf8_value_ <= 0b000'0000'0111'1111) {                 // NOLINT
+    extra_byte = 0;                                          // NOLINT
+  } else if (utf8_value_ <= 0b000'0111'1111'1111) {          // NOLINT
+    extra_byte = 1;                                          // NOLINT
+  } else if (utf8_value_ <= 0b1111'1111'1111'1111) {         // NOLINT
+    extra_byte = 2;                                          // NOLINT
+  } else if (utf8_value_ <= 0b1'0000'1111'1111'1111'1111) {  // NOLINT
+    extra_byte = 3;                                          // NOLINT
+  } else {                                                   // NOLINT
     return DROP;
   }
 
-  if (extra_byte != position_) {
+  if (extra_byte + 1 != pending_.size()) {
     return DROP;
   }
 
   return CHARACTER;
 }
 
-TerminalInputParser::Output TerminalInputParser::ParseESC() {
-  if (!Eat()) {
-    return UNCOMPLETED;
-  }
-  switch (Current()) {
+TerminalInputParser::Output TerminalInputParser::ParseESC(unsigned char c) {
+  switch (c) {
     case 'P':
-      return ParseDCS();
+      state_ = State::DCS;
+      return UNCOMPLETED;
     case '[':
-      return ParseCSI();
+      state_ = State::CSI;
+      csi_argument_ = 0;
+      csi_arguments_.clear();
+      return UNCOMPLETED;
     case ']':
-      return ParseOSC();
+      state_ = State::OSC;
+      return UNCOMPLETED;
 
     // Expecting 2 characters.
     case ' ':
@@ -285,12 +426,10 @@ TerminalInputParser::Output TerminalInputParser::ParseESC() {
     case '*':
     case '+':
     case 'O':
-    case 'N': {
-      if (!Eat()) {
-        return UNCOMPLETED;
-      }
-      return SPECIAL;
-    }
+    case 'N':
+      state_ = State::ESCIntermediate;
+      return UNCOMPLETED;
+
     // Expecting 1 character:
     default:
       return SPECIAL;
@@ -299,122 +438,80 @@ TerminalInputParser::Output TerminalInputParser::ParseESC() {
 
 // ESC P ... ESC BACKSLASH
 TerminalInputParser::Output TerminalInputParser::ParseDCS() {
-  // Parse until the string terminator ST.
-  while (true) {
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
-
-    if (Current() != '\x1B') {
-      continue;
-    }
-
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
-
-    if (Current() != '\\') {
-      continue;
-    }
-
-    if (pending_.size() == 10 &&  //
-        pending_[2] == '1' &&     //
-        pending_[3] == '$' &&     //
-        pending_[4] == 'r' &&     //
-        true) {
-      Output output(CURSOR_SHAPE);
-      output.cursor_shape = pending_[5] - '0';
-      return output;
-    }
-
-    return SPECIAL;
+  if (pending_.size() == 10 &&  //
+      pending_[2] == '1' &&     //
+      pending_[3] == '$' &&     //
+      pending_[4] == 'r' &&     //
+      true) {
+    Output output(CURSOR_SHAPE);
+    output.cursor_shape = pending_[5] - '0';
+    return output;
   }
-}
-
-TerminalInputParser::Output TerminalInputParser::ParseCSI() {
-  bool altered = false;
-  int argument = 0;
-  std::vector<int> arguments;
-  while (true) {
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
 
-    if (Current() == '<') {
-      altered = true;
-      continue;
-    }
+  return SPECIAL;
+}
 
-    if (Current() >= '0' && Current() <= '9') {
-      argument *= 10;  // NOLINT
-      argument += Current() - '0';
-      continue;
-    }
+TerminalInputParser::Output TerminalInputParser::ParseCSI(unsigned char c) {
+  // Marker of the SGR mouse reporting: ESC [ < ... M
+  if (c == '<') {
+    return UNCOMPLETED;
+  }
 
-    if (Current() == ';') {
-      arguments.push_back(argument);
-      argument = 0;
-      continue;
-    }
+  if (c >= '0' && c <= '9') {
+    csi_argument_ *= 10;  // NOLINT
+    csi_argument_ += c - '0';
+    return UNCOMPLETED;
+  }
 
-    // CSI is terminated by a character in the range 0x40–0x7E
-    // (ASCII @A–Z[\]^_`a–z{|}~),
-    if (Current() >= '@' && Current() <= '~' &&
-        // Note: I don't remember why we exclude '<'
-        Current() != '<' &&
-        // To handle F1-F4, we exclude '['.
-        Current() != '[') {
-      arguments.push_back(argument);
-      argument = 0;  // NOLINT
-
-      switch (Current()) {
-        case 'M':
-          return ParseMouse(altered, true, std::move(arguments));
-        case 'm':
-          return ParseMouse(altered, false, std::move(arguments));
-        case 'R':
-          return ParseCursorPosition(std::move(arguments));
-        default:
-          return SPECIAL;
-      }
-    }
+  if (c == ';') {
+    csi_arguments_.push_back(csi_argument_);
+    csi_argument_ = 0;
+    return UNCOMPLETED;
+  }
 
-    // Invalid ESC in CSI.
-    if (Current() == '\x1B') {
-      return SPECIAL;
+  // CSI is terminated by a character in the range 0x40–0x7E
+  // (ASCII @A–Z[\]^_`a–z{|}~),
+  if (c >= '@' && c <= '~' &&
+      // Note: I don't remember why we exclude '<'
+      c != '<' &&
+      // To handle F1-F4, we exclude '['.
+      c != '[') {
+    csi_arguments_.push_back(csi_argument_);
+    csi_argument_ = 0;  // NOLINT
+
+    switch (c) {
+      case 'M':
+        return ParseMouse(true);
+      case 'm':
+        return ParseMouse(false);
+      case 'R':
+        return ParseCursorPosition();
+      case '~':
+        if (bracketed_paste_ && csi_arguments_.size() == 1 &&
+            csi_arguments_[0] == 200) {  // NOLINT
+          return PASTE_BEGIN;
+        }
+        return SPECIAL;
+      default:
+        return SPECIAL;
     }
   }
-}
 
-TerminalInputParser::Output TerminalInputParser::ParseOSC() {
-  // Parse until the string terminator ST.
-  while (true) {
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
-    if (Current() != '\x1B') {
-      continue;
-    }
-    if (!Eat()) {
-      return UNCOMPLETED;
-    }
-    if (Current() != '\\') {
-      continue;
-    }
+  // Invalid ESC in CSI.
+  if (c == '\x1B') {
     return SPECIAL;
   }
+
+  return UNCOMPLETED;
 }
 
 TerminalInputParser::Output TerminalInputParser::ParseMouse(  // NOLINT
-    bool altered,
-    bool pressed,
-    std::vector<int> arguments) {
+    bool pressed) {
+  const std::vector<int>& arguments = csi_arguments_;
   if (arguments.size() != 3) {
     return SPECIAL;
   }
 
-  (void)altered;
-
   Output output(MOUSE);
   output.mouse.motion = Mouse::Motion(pressed);  // NOLINT
 
@@ -450,8 +547,8 @@ TerminalInputParser::Output TerminalInputParser::ParseMouse(  // NOLINT
 }
 
 // NOLINTNEXTLINE
-TerminalInputParser::Output TerminalInputParser::ParseCursorPosition(
-    std::vector<int> arguments) {
+TerminalInputParser::Output TerminalInputParser::ParseCursorPosition() {
+  const std::vector<int>& arguments = csi_arguments_;
   if (arguments.size() != 2) {
     return SPECIAL;
   }
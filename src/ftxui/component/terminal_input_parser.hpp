@@ -4,9 +4,12 @@
 #ifndef FTXUI_COMPONENT_TERMINAL_INPUT_PARSER
 #define FTXUI_COMPONENT_TERMINAL_INPUT_PARSER
 
-#include <functional>
-#include <string>  // for string
-#include <vector>  // for vector
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <functional>   // for function
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
 #include "ftxui/component/mouse.hpp"  // for Mouse
 
@@ -14,15 +17,30 @@ namespace ftxui {
 struct Event;
 
 // Parse a sequence of |char| accross |time|. Produces |Event|.
+//
+// The parser is a state machine: every byte is looked at once, and the
+// sequences can be split arbitrarily across calls to |Add|.
 class TerminalInputParser {
  public:
-  explicit TerminalInputParser(std::function<void(Event)> out);
+  // When |bracketed_paste| is false, ESC[200~ doesn't start a paste, and is
+  // sent as a special event instead.
+  explicit TerminalInputParser(std::function<void(Event)> out,
+                               bool bracketed_paste = true);
+
+  // Report |time| milliseconds elapsed without input, since the previous call
+  // to Add() or Timeout().
   void Timeout(int time);
   void Add(char c);
+  void Add(std::string_view input);
+
+  // Whether some characters are waiting for the sequence to be completed, or
+  // for the timeout to elapse. This includes an unterminated paste.
+  bool HasPendingInput() const {
+    return !pending_.empty() || state_ == State::Paste;
+  }
 
  private:
-  unsigned char Current();
-  bool Eat();
+  size_t AddPaste(std::string_view input);
 
   enum Type {
     UNCOMPLETED,
@@ -32,6 +50,21 @@ class TerminalInputParser {
     CURSOR_POSITION,
     CURSOR_SHAPE,
     SPECIAL,
+    PASTE_BEGIN,
+  };
+
+  // Where the parser is, in between two bytes.
+  enum class State {
+    Ground,
+    UTF8,             // Expecting UTF-8 continuation bytes.
+    ESC,              // After ESC.
+    ESCIntermediate,  // After ESC and a character expecting one more.
+    CSI,              // After ESC [
+    DCS,              // After ESC P
+    DCSEscape,        // After ESC inside a DCS.
+    OSC,              // After ESC ]
+    OSCEscape,        // After ESC inside an OSC.
+    Paste,            // In between ESC[200~ and ESC[201~.
   };
 
   struct CursorPosition {
@@ -52,19 +85,32 @@ class TerminalInputParser {
   };
 
   void Send(Output output);
-  Output Parse();
-  Output ParseUTF8();
-  Output ParseESC();
+  Output Parse(unsigned char c);
+  Output ParseGround(unsigned char c);
+  Output ParseUTF8(unsigned char c);
+  Output ParseESC(unsigned char c);
+  Output ParseCSI(unsigned char c);
   Output ParseDCS();
-  Output ParseCSI();
-  Output ParseOSC();
-  Output ParseMouse(bool altered, bool pressed, std::vector<int> arguments);
-  Output ParseCursorPosition(std::vector<int> arguments);
+  Output ParseMouse(bool pressed);
+  Output ParseCursorPosition();
+  Output CompleteUTF8();
 
   std::function<void(Event)> out_;
-  int position_ = -1;
+  bool bracketed_paste_;
   int timeout_ = 0;
   std::string pending_;
+  State state_ = State::Ground;
+
+  // UTF-8: the code point decoded so far, and the continuation bytes left.
+  uint32_t utf8_value_ = 0;
+  int utf8_remaining_ = 0;
+
+  // CSI: the arguments parsed so far.
+  int csi_argument_ = 0;
+  std::vector<int> csi_arguments_;
+
+  // Bracketed paste: the text received since ESC[200~.
+  std::string paste_;
 };
 
 }  // namespace ftxui
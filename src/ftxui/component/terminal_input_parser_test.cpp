@@ -5,6 +5,8 @@
 #include <functional>                 // for function
 #include <initializer_list>           // for initializer_list
 #include <memory>                     // for allocator, unique_ptr
+#include <string>                     // for string
+#include <string_view>                // for string_view
 #include <vector>                     // for vector
 
 #include "ftxui/component/event.hpp"  // for Event, Event::Return, Event::ArrowDown, Event::ArrowLeft, Event::ArrowRight, Event::ArrowUp, Event::Backspace, Event::End, Event::Home, Event::Custom, Event::Delete, Event::F1, Event::F10, Event::F11, Event::F12, Event::F2, Event::F3, Event::F4, Event::F5, Event::F6, Event::F7, Event::F8, Event::F9, Event::PageDown, Event::PageUp, Event::Tab, Event::TabReverse, Event::Escape
@@ -477,5 +479,156 @@ TEST(Event, DeviceControlString) {
   EXPECT_EQ(1, received_events[0].cursor_shape());
 }
 
+TEST(Event, BracketedPaste) {
+  std::vector<Event> received_events;
+  auto parser = TerminalInputParser(
+      [&](Event event) { received_events.push_back(std::move(event)); });
+  const std::string pasted = "a\x1B[Ab\r\n\x1B[201c测";
+  for (char c : "\x1B[200~" + pasted + "\x1B[201~z") {
+    parser.Add(c);
+  }
+
+  ASSERT_EQ(2, received_events.size());
+  EXPECT_TRUE(received_events[0].is_paste());
+  EXPECT_FALSE(received_events[0].is_character());
+  EXPECT_EQ(received_events[0].paste(), pasted);
+  EXPECT_EQ(received_events[0], Event::Paste(pasted));
+  EXPECT_NE(received_events[0], Event::Character(pasted));
+  EXPECT_EQ(received_events[1], Event::Character('z'));
+  EXPECT_FALSE(parser.HasPendingInput());
+}
+
+// The events must not depend on how the input is split across calls to Add.
+TEST(Event, ChunkedInput) {
+  std::string stream =
+      "ab\r\x7F"
+      "测€\xC3\x28z"          // UTF-8, and invalid UTF-8.
+      "\x1B[A\x1BOB\x1B[[A"  // Arrows and F1.
+      "\x1B[<0;12;34M\x1B[<32;13;35M\x1B[<0;13;35m"  // Mouse drag.
+      "\x1B[5;10R"                                    // Cursor position.
+      "\x1BP1$r1 q\x1B\\"                             // Cursor shape.
+      "\x1B]0;title\x1B\\"                            // OSC.
+      "\x1B[200~pasted\r\ntext\x1B[201~"              // Paste.
+      "\x1B\x1B[";
+
+  // Some garbage, to cover the invalid sequences.
+  uint32_t seed = 42;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    stream += char(seed >> 16);
+  }
+
+  auto parse = [&](size_t chunk) {
+    std::vector<Event> events;
+    auto parser = TerminalInputParser(
+        [&](Event event) { events.push_back(std::move(event)); });
+    for (size_t i = 0; i < stream.size(); i += chunk) {
+      parser.Add(std::string_view(stream).substr(i, chunk));
+    }
+    parser.Timeout(50);
+    return events;
+  };
+
+  std::vector<Event> expected;
+  auto parser = TerminalInputParser(
+      [&](Event event) { expected.push_back(std::move(event)); });
+  for (char c : stream) {
+    parser.Add(c);
+  }
+  parser.Timeout(50);
+
+  EXPECT_EQ(expected[0], Event::Character('a'));
+  EXPECT_EQ(expected[2], Event::Return);
+  EXPECT_EQ(expected[3], Event::Backspace);
+  EXPECT_EQ(expected[4], Event::Character("测"));
+  EXPECT_EQ(expected[6], Event::Character('z'));
+  EXPECT_EQ(expected[7], Event::ArrowUp);
+  EXPECT_EQ(expected[8], Event::ArrowDown);
+  EXPECT_EQ(expected[9], Event::F1);
+  EXPECT_TRUE(expected[10].is_mouse());
+  EXPECT_EQ(expected[11].mouse().motion, Mouse::Moved);
+  EXPECT_TRUE(expected[13].is_cursor_position());
+  EXPECT_TRUE(expected[14].is_cursor_shape());
+  EXPECT_EQ(expected[16], Event::Paste("pasted\r\ntext"));
+
+  for (size_t chunk : {2, 3, 5, 7, 64, 4096}) {
+    EXPECT_EQ(parse(chunk), expected) << "chunk=" << chunk;
+  }
+}
+
+// A paste whose end never comes is flushed after a timeout.
+TEST(Event, BracketedPasteTimeout) {
+  std::vector<Event> received_events;
+  auto parser = TerminalInputParser(
+      [&](Event event) { received_events.push_back(std::move(event)); });
+  parser.Add("\x1B[200~abc\x1B[20");
+  EXPECT_TRUE(parser.HasPendingInput());
+  parser.Timeout(50);
+  EXPECT_TRUE(received_events.empty());
+  parser.Timeout(1000);
+  EXPECT_FALSE(parser.HasPendingInput());
+  parser.Add("\x03");
+
+  ASSERT_EQ(2, received_events.size());
+  EXPECT_EQ(received_events[0], Event::Paste("abc\x1B[20"));
+  EXPECT_EQ(received_events[1], Event::Special("\x03"));
+}
+
+// The timeouts are reached after the same time, whatever the interval in
+// between two calls. ScreenInteractive reports the time elapsed every 20ms on
+// POSIX, and every 16ms on Windows and Emscripten.
+TEST(Event, TimeoutIntervals) {
+  for (const int interval : {1, 16, 20}) {
+    std::vector<Event> received_events;
+    auto parser = TerminalInputParser(
+        [&](Event event) { received_events.push_back(std::move(event)); });
+
+    parser.Add('\x1B');
+    int elapsed = 0;
+    while (received_events.empty()) {
+      parser.Timeout(interval);
+      elapsed += interval;
+    }
+    EXPECT_GE(elapsed, 50);
+    EXPECT_LT(elapsed, 50 + interval);
+    EXPECT_EQ(received_events[0], Event::Escape);
+
+    parser.Add("\x1B[200~abc");
+    elapsed = 0;
+    while (received_events.size() == 1) {
+      parser.Timeout(interval);
+      elapsed += interval;
+    }
+    EXPECT_GE(elapsed, 1000);
+    EXPECT_LT(elapsed, 1000 + interval);
+    EXPECT_EQ(received_events[1], Event::Paste("abc"));
+
+    // A paste stalling for less than the timeout isn't split.
+    parser.Add("\x1B[200~abc");
+    for (int i = 0; i < 900; i += interval) {
+      parser.Timeout(interval);
+    }
+    parser.Add("def\x1B[201~");
+    ASSERT_EQ(received_events.size(), 3u);
+    EXPECT_EQ(received_events[2], Event::Paste("abcdef"));
+  }
+}
+
+// A large paste is sent by parts, without losing any of its text.
+TEST(Event, BracketedPasteLarge) {
+  std::vector<Event> received_events;
+  auto parser = TerminalInputParser(
+      [&](Event event) { received_events.push_back(std::move(event)); });
+  const std::string pasted(5 << 20, 'x');
+  parser.Add("\x1B[200~");
+  parser.Add(pasted);
+  parser.Add("\x1B[201");
+  parser.Add("~");
+
+  ASSERT_EQ(2, received_events.size());
+  EXPECT_EQ(received_events[0].paste() + received_events[1].paste(), pasted);
+  EXPECT_FALSE(parser.HasPendingInput());
+}
+
 }  // namespace ftxui
    // NOLINTEND
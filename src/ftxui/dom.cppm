@@ -3,6 +3,7 @@
 
 export module ftxui.dom;
 
+export import ftxui.dom.arena;
 export import ftxui.dom.canvas;
 export import ftxui.dom.deprecated;
 export import ftxui.dom.direction;
@@ -10,6 +11,7 @@ export import ftxui.dom.elements;
 export import ftxui.dom.flexbox_config;
 export import ftxui.dom.linear_gradient;
 export import ftxui.dom.node;
+export import ftxui.dom.render_pool;
 export import ftxui.dom.requirement;
 export import ftxui.dom.selection;
 export import ftxui.dom.table;
@@ -0,0 +1,120 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/arena.hpp"
+
+#include <atomic>   // for atomic
+#include <cstddef>  // for size_t, max_align_t
+#include <cstdint>  // for uintptr_t
+#include <new>      // for operator new, operator delete
+
+namespace ftxui {
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local Arena* g_current_arena = nullptr;
+
+constexpr size_t kChunkSize = 64 * 1024;  // NOLINT
+}  // namespace
+
+// A block of memory allocated by bumping |used|. Every allocation is preceded
+// by a pointer to its chunk, so that it can be released without the arena,
+// from any thread. The chunk is freed once both the arena and the allocations
+// released it.
+struct alignas(std::max_align_t) Arena::Chunk {
+  std::atomic<size_t> references{1};  // The arena, and the allocations.
+  size_t used = 0;
+  size_t capacity = 0;
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }  // NOLINT
+};
+
+Arena::Arena() = default;
+
+Arena::~Arena() {
+  for (Chunk* chunk : chunks_) {
+    Release(chunk);
+  }
+}
+
+void Arena::Reset() {
+  for (Chunk* chunk : chunks_) {
+    if (chunk->references == 1) {
+      chunk->used = 0;
+    }
+  }
+  current_ = 0;
+}
+
+void* Arena::Allocate(size_t size, size_t alignment) {
+  auto fit = [&](Chunk* chunk) -> void* {
+    const auto begin = reinterpret_cast<uintptr_t>(chunk->data());  // NOLINT
+    uintptr_t address = begin + chunk->used + sizeof(Chunk*);
+    address = (address + alignment - 1) & ~(alignment - 1);
+    if (address + size > begin + chunk->capacity) {
+      return nullptr;
+    }
+    chunk->used = address + size - begin;
+    chunk->references.fetch_add(1, std::memory_order_relaxed);
+    auto* pointer = reinterpret_cast<void*>(address);  // NOLINT
+    *(static_cast<Chunk**>(pointer) - 1) = chunk;
+    return pointer;
+  };
+
+  // Large allocations get a chunk of their own. A chunk whose allocations were
+  // all released is reused, so that the memory doesn't grow with every frame.
+  const size_t needed = size + alignment + sizeof(Chunk*);
+  if (needed > kChunkSize / 2) {
+    for (Chunk* chunk : chunks_) {
+      if (chunk->references == 1 && chunk->capacity >= needed) {
+        chunk->used = 0;
+        return fit(chunk);
+      }
+    }
+    return fit(NewChunk(needed));
+  }
+
+  for (; current_ < chunks_.size(); ++current_) {
+    if (void* pointer = fit(chunks_[current_])) {
+      return pointer;
+    }
+  }
+  Chunk* chunk = NewChunk(kChunkSize);
+  current_ = chunks_.size() - 1;
+  return fit(chunk);
+}
+
+// static
+void Arena::Deallocate(void* pointer) {
+  Release(*(static_cast<Chunk**>(pointer) - 1));
+}
+
+// static
+void Arena::Release(Chunk* chunk) {
+  if (chunk->references.fetch_sub(1) == 1) {
+    ::operator delete(chunk);
+  }
+}
+
+Arena::Chunk* Arena::NewChunk(size_t capacity) {
+  void* memory = ::operator new(sizeof(Chunk) + capacity);
+  Chunk* chunk = new (memory) Chunk;
+  chunk->capacity = capacity;
+  chunks_.push_back(chunk);
+  return chunk;
+}
+
+// static
+Arena* Arena::Current() {
+  return g_current_arena;
+}
+
+Arena::Scope::Scope(Arena* arena) : previous_(g_current_arena) {
+  g_current_arena = arena;
+}
+
+Arena::Scope::~Scope() {
+  g_current_arena = previous_;
+}
+
+}  // namespace ftxui
@@ -0,0 +1,18 @@
+/// @module ftxui.dom.arena
+/// @brief Module file for the Arena class of the Dom module
+
+module;
+
+#include <ftxui/dom/arena.hpp>
+
+export module ftxui.dom.arena;
+
+/**
+ * @namespace ftxui
+ * @brief The FTXUI ftxui:: namespace
+ */
+export namespace ftxui {
+    using ftxui::Arena;
+    using ftxui::ArenaAllocator;
+    using ftxui::MakeNode;
+}
@@ -0,0 +1,106 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <cstddef>  // for size_t, max_align_t
+#include <string>   // for allocator, string, to_string
+#include <vector>   // for vector
+
+#include "ftxui/dom/arena.hpp"     // for Arena, Arena::Scope
+#include "ftxui/dom/elements.hpp"  // for operator|, text, border, hbox, vbox, gauge, Element
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+#include "gtest/gtest.h"  // for Test, EXPECT_EQ, Message, TEST, TestPartResult
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+Element Document(int i) {
+  return vbox({
+             hbox({text("frame "), text(std::to_string(i)) | bold}),
+             gauge(0.5f),
+         }) |
+         border;
+}
+
+std::string ToString(Element element) {
+  Screen screen(12, 4);
+  Render(screen, element);
+  return screen.ToString();
+}
+}  // namespace
+
+TEST(ArenaTest, SameAsHeap) {
+  Arena arena;
+  for (int i = 0; i < 3; ++i) {
+    arena.Reset();
+    Arena::Scope scope(&arena);
+    EXPECT_EQ(Arena::Current(), &arena);
+    EXPECT_EQ(ToString(Document(i)), ToString([&] {
+                Arena::Scope heap(nullptr);
+                return Document(i);
+              }()));
+  }
+  EXPECT_EQ(Arena::Current(), nullptr);
+}
+
+TEST(ArenaTest, ElementOutlivesFrame) {
+  Arena arena;
+  Element kept;
+  {
+    Arena::Scope scope(&arena);
+    kept = Document(1);
+  }
+  const std::string expected = ToString(kept);
+
+  // The memory holding |kept| must not be reused by the next frames.
+  for (int i = 0; i < 1000; ++i) {
+    arena.Reset();
+    Arena::Scope scope(&arena);
+    ToString(Document(i));
+  }
+  EXPECT_EQ(ToString(kept), expected);
+}
+
+TEST(ArenaTest, ElementOutlivesArena) {
+  Element kept;
+  {
+    Arena arena;
+    Arena::Scope scope(&arena);
+    kept = Document(1);
+  }
+  EXPECT_EQ(ToString(kept), ToString(Document(1)));
+}
+
+// The chunks of the large allocations are reused by the next frames.
+TEST(ArenaTest, LargeAllocationReused) {
+  Arena arena;
+  const size_t size = 100 * 1024;
+  void* previous = nullptr;
+  for (int i = 0; i < 3; ++i) {
+    arena.Reset();
+    void* pointer = arena.Allocate(size, alignof(std::max_align_t));
+    if (previous != nullptr) {
+      EXPECT_EQ(pointer, previous);
+    }
+    previous = pointer;
+    Arena::Deallocate(pointer);
+  }
+
+  // A growing container reuses the chunks released by its previous buffers.
+  for (int i = 0; i < 3; ++i) {
+    arena.Reset();
+    std::vector<int, ArenaAllocator<int>> values{ArenaAllocator<int>(&arena)};
+    for (int j = 0; j < 100000; ++j) {
+      values.push_back(j);
+    }
+    if (i == 0) {
+      previous = values.data();
+    } else {
+      EXPECT_EQ(values.data(), previous);
+    }
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -3,13 +3,64 @@
 // the LICENSE file.
 #include <benchmark/benchmark.h>
 
-#include "ftxui/dom/elements.hpp"  // for gauge, separator, operator|, text, Element, hbox, vbox, blink, border, inverted
-#include "ftxui/dom/node.hpp"      // for Render
-#include "ftxui/screen/screen.hpp"  // for Screen
+#include <atomic>   // for atomic
+#include <cstdint>  // for int64_t
+#include <cstdlib>  // for malloc, free
+#include <memory>   // for make_shared, make_unique, unique_ptr
+#include <new>      // for bad_alloc
+#include <string>   // for string, to_string
+#include <vector>   // for vector
+
+#include "ftxui/dom/arena.hpp"     // for Arena, Arena::Scope
+#include "ftxui/dom/canvas.hpp"    // for Canvas
+#include "ftxui/dom/elements.hpp"  // for filler, gauge, separator, operator|, text, Element, hbox, vbox, blink, border, inverted
+#include "ftxui/dom/linear_gradient.hpp"  // for LinearGradient
+#include "ftxui/dom/node.hpp"             // for Render
+#include "ftxui/dom/render_pool.hpp"  // for RenderPool, RenderPool::Scope
+#include "ftxui/dom/table.hpp"     // for Table
+#include "ftxui/screen/color.hpp"     // for Color
+#include "ftxui/screen/screen.hpp"    // for Screen
+#include "ftxui/screen/string.hpp"    // for string_width, Utf8ToGlyphs
+#include "ftxui/screen/terminal.hpp"  // for SetColorSupport, ColorSupport
 
 // NOLINTBEGIN
+
+// Count the heap allocations, for the benchmarks reporting them.
+static std::atomic<int64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+  std::free(pointer);
+}
+
 namespace ftxui {
 
+// A line of text, made of |repetitions| repetitions of a sample. The sample
+// is pure ASCII, CJK or mixed with combining characters.
+static std::string TextSample(int kind, int repetitions) {
+  const char* samples[] = {
+      "The quick brown fox jumps over the lazy dog. ",
+      "测试文字排版。",
+      "Café á 测 mixed 🚀 text. ",
+  };
+  std::string out;
+  for (int i = 0; i < repetitions; ++i) {
+    out += samples[kind];
+  }
+  return out;
+}
+
 static void BencharkBasic(benchmark::State& state) {
   while (state.KeepRunning()) {
     auto document = vbox({
@@ -48,6 +99,315 @@ static void BencharkText(benchmark::State& state) {
 }
 BENCHMARK(BencharkText)->DenseRange(0, 10, 1);
 
+// A log viewer, displaying one text element per line.
+static void BenchmarkTextLines(benchmark::State& state) {
+  const int lines = state.range(0);
+  Screen screen(80, lines);
+  for (auto _ : state) {
+    Elements elements;
+    for (int i = 0; i < lines; ++i) {
+      elements.push_back(
+          text("2025-05-07 12:00:00 [info] Request handled in 12ms, ok ✓"));
+    }
+    Render(screen, vbox(std::move(elements)));
+  }
+}
+BENCHMARK(BenchmarkTextLines)->Arg(100)->Arg(10000);
+
+// A scrollable log viewer, displaying a few rows of a long list.
+static void BenchmarkFrameLines(benchmark::State& state) {
+  const int lines = state.range(0);
+  Screen screen(80, 50);
+  for (auto _ : state) {
+    Elements elements;
+    for (int i = 0; i < lines; ++i) {
+      auto line = hbox({
+          text("[info] "),
+          text("Request handled in 12ms"),
+      });
+      if (i == lines / 2) {
+        line |= focus;
+      }
+      elements.push_back(std::move(line));
+    }
+    Render(screen, vbox(std::move(elements)) | yframe);
+  }
+}
+BENCHMARK(BenchmarkFrameLines)->Arg(1000)->Arg(100000);
+
+// A leaf counting how many times the layout visits it.
+class VisitCounter : public Node {
+ public:
+  explicit VisitCounter(int64_t* visits) : visits_(visits) {}
+  void ComputeRequirement() override {
+    requirement_.min_x = 10;
+    requirement_.min_y = 1;
+    ++*visits_;
+  }
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    ++*visits_;
+  }
+
+ private:
+  int64_t* visits_;
+};
+
+// A dashboard made of many rows, and a single paragraph requiring several
+// iterations of the layout.
+static void BenchmarkLayoutVisits(benchmark::State& state) {
+  int64_t visits = 0;
+  Elements rows = {paragraph(TextSample(0, 10))};
+  for (int i = 0; i < state.range(0); ++i) {
+    rows.push_back(hbox({
+        std::make_shared<VisitCounter>(&visits),
+        separator(),
+        std::make_shared<VisitCounter>(&visits),
+    }));
+  }
+  auto document = vbox(std::move(rows)) | border;
+  Screen screen(80, 50);
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+  state.counters["visits_per_frame"] =
+      double(visits) / double(state.iterations());
+}
+BENCHMARK(BenchmarkLayoutVisits)->Arg(100)->Arg(10000);
+
+// Render again a paragraph of |state.range(0)| words, kept in between frames.
+static void BenchmarkParagraphRerender(benchmark::State& state) {
+  auto document = paragraph(TextSample(0, state.range(0) / 9));
+  Screen screen(80, 50);
+  Render(screen, document);
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkParagraphRerender)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// A frame of the examples/dom/package_manager dashboard: a list of tasks with
+// their progress, and a summary. Built from the heap, or from an Arena.
+static void BenchmarkDashboardAllocations(benchmark::State& state) {
+  const bool use_arena = state.range(0);
+  auto to_text = [](int number) {
+    return text(std::to_string(number)) | size(WIDTH, EQUAL, 3);
+  };
+  auto render = [&](int frame) {
+    Elements tasks;
+    for (int i = 0; i < 12; ++i) {
+      const int downloaded = (frame + i * 7) % 100;
+      tasks.push_back(hbox({
+          text("download file_" + std::to_string(i) + ".png") |
+              (downloaded == 99 ? dim : bold),
+          separator(),
+          to_text(downloaded),
+          text("/"),
+          to_text(99),
+          separator(),
+          gauge(downloaded / 99.f),
+      }));
+    }
+    auto summary = vbox({
+        hbox({text("- done:   "), to_text(frame % 12) | bold}) |
+            color(Color::Green),
+        hbox({text("- active: "), to_text(3) | bold}) |
+            color(Color::RedLight),
+        hbox({text("- queue:  "), to_text(9) | bold}) | color(Color::Red),
+    });
+    return vbox({
+        window(text(" Task "), vbox(std::move(tasks))),
+        hbox({window(text(" Summary "), summary), filler()}),
+    });
+  };
+
+  Arena arena;
+  Screen screen(80, 20);
+  int frame = 0;
+  const int64_t allocations = g_allocations.load();
+  for (auto _ : state) {
+    if (use_arena) {
+      arena.Reset();
+    }
+    const Arena::Scope scope(use_arena ? &arena : nullptr);
+    Render(screen, render(frame++));
+  }
+  state.counters["allocs_per_frame"] =
+      double(g_allocations.load() - allocations) / double(state.iterations());
+}
+BENCHMARK(BenchmarkDashboardAllocations)->Arg(0)->Arg(1);
+
+// Render again a grid of 200x50 cells, kept in between frames.
+static void BenchmarkGridboxRerender(benchmark::State& state) {
+  std::vector<Elements> lines;
+  for (int y = 0; y < 50; ++y) {
+    Elements line;
+    for (int x = 0; x < 200; ++x) {
+      line.push_back(text(std::to_string((x * y) % 10)));
+    }
+    lines.push_back(std::move(line));
+  }
+  auto document = gridbox(std::move(lines));
+  Screen screen(200, 50);
+  Render(screen, document);
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkGridboxRerender);
+
+// A wall of 5x4 charts on a 4k wide terminal, rendered by the calling thread
+// and |state.range(0)| threads of a RenderPool. -1 means no pool.
+static void BenchmarkParallelRender(benchmark::State& state) {
+  const int threads = state.range(0);
+  auto chart = [](int i) {
+    return canvas([i](Canvas& c) {
+             for (int x = 0; x < c.width(); ++x) {
+               const int y = (x * x * (i + 1) / 7 + x * 13) % c.height();
+               c.DrawPointLine(x, c.height() - 1, x, y, Color::Green);
+             }
+             c.DrawText(0, 0, "chart " + std::to_string(i));
+           }) |
+           border | flex;
+  };
+  std::vector<Elements> lines;
+  for (int y = 0; y < 4; ++y) {
+    Elements line;
+    for (int x = 0; x < 5; ++x) {
+      line.push_back(chart(y * 5 + x));
+    }
+    lines.push_back(std::move(line));
+  }
+  auto document = gridbox(std::move(lines));
+  Screen screen(400, 100);
+  std::unique_ptr<RenderPool> pool;
+  if (threads >= 0) {
+    pool = std::make_unique<RenderPool>(threads);
+  }
+  const RenderPool::Scope scope(pool.get());
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkParallelRender)
+    ->Arg(-1)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(3)
+    ->Arg(7)
+    ->UseRealTime();
+
+// A table of 100k rows, displayed in a frame. Either regular, or virtualized.
+static void BenchmarkTable(benchmark::State& state) {
+  const int rows = 100000;
+  const bool virtualized = state.range(0);
+  auto cell = [](int x, int y) {
+    return text(x == 0 ? std::to_string(y) : "Request handled");
+  };
+  Screen screen(80, 50);
+  for (auto _ : state) {
+    Table table;
+    if (virtualized) {
+      table = Table(2, rows, cell);
+    } else {
+      std::vector<std::vector<Element>> elements(rows);
+      for (int y = 0; y < rows; ++y) {
+        elements[y] = {cell(0, y), cell(1, y)};
+      }
+      table = Table(std::move(elements));
+    }
+    table.SelectAll().Border(LIGHT);
+    table.SelectAll().SeparatorVertical(LIGHT);
+    table.SelectRow(0).BorderBottom(DOUBLE);
+    Render(screen, table.Render() | focusPositionRelative(0.f, 0.5f) | yframe);
+  }
+}
+BENCHMARK(BenchmarkTable)->Arg(0)->Arg(1);
+
+// Canvas of 200x100 cells, i.e. 400x400 braille dots.
+static void BenchmarkCanvasPoints(benchmark::State& state) {
+  const bool colored = state.range(0);
+  for (auto _ : state) {
+    auto document = canvas(400, 400, [&](Canvas& c) {
+      unsigned int seed = 0;
+      for (int i = 0; i < 50000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        const int x = (seed >> 8) % 400;
+        const int y = (seed >> 20) % 400;
+        if (colored) {
+          c.DrawPoint(x, y, true, Color::Red);
+        } else {
+          c.DrawPointOn(x, y);
+        }
+      }
+    });
+    Screen screen(200, 100);
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkCanvasPoints)->Arg(0)->Arg(1);
+
+// Plot 100k points on a canvas of 200x100 cells, one by one, or in bulk.
+static void BenchmarkCanvasDrawPoints(benchmark::State& state) {
+  std::vector<Canvas::Point> points(100000);
+  unsigned int seed = 0;
+  for (auto& point : points) {
+    seed = seed * 1103515245 + 12345;
+    point.x = (seed >> 8) % 400;
+    point.y = (seed >> 20) % 400;
+  }
+  for (auto _ : state) {
+    Canvas c(400, 400);
+    switch (state.range(0)) {
+      case 0:
+        for (const auto& point : points) {
+          c.DrawPoint(point.x, point.y, true, Color::Red);
+        }
+        break;
+      case 1:
+        c.DrawPoints(points, Color::Red);
+        break;
+      case 2:
+        for (const auto& point : points) {
+          c.DrawPointOn(point.x, point.y);
+        }
+        break;
+      case 3:
+        c.DrawPoints(points);
+        break;
+    }
+    benchmark::DoNotOptimize(c);
+  }
+}
+BENCHMARK(BenchmarkCanvasDrawPoints)->DenseRange(0, 3);
+
+static void BenchmarkCanvasLines(benchmark::State& state) {
+  for (auto _ : state) {
+    auto document = canvas(400, 400, [&](Canvas& c) {
+      for (int i = 0; i < 400; i += 4) {
+        c.DrawPointLine(0, i, 399, 399 - i);
+        c.DrawBlockLine(i, 0, 399 - i, 399, Color::Blue);
+      }
+    });
+    Screen screen(200, 100);
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkCanvasLines);
+
+static void BenchmarkCanvasEllipseFilled(benchmark::State& state) {
+  for (auto _ : state) {
+    auto document = canvas(400, 400, [&](Canvas& c) {
+      c.DrawPointEllipseFilled(200, 200, 190, 150);
+      c.DrawPointCircleFilled(100, 100, 50, Color::Red);
+      c.DrawBlockEllipseFilled(300, 300, 80, 60, Color::Green);
+    });
+    Screen screen(200, 100);
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkCanvasEllipseFilled);
+
 static void BenchmarkStyle(benchmark::State& state) {
   while (state.KeepRunning()) {
     Elements elements;
@@ -82,5 +442,156 @@ BENCHMARK(BenchmarkStyle)
         benchmark::CreateDenseRange(10, 200, 20),  // Screen width.
     });
 
+// Screen sizes used by the Screen benchmarks: 80x24, 200x60 and 400x120.
+static void ScreenSizes(benchmark::internal::Benchmark* b) {
+  b->Args({80, 24});
+  b->Args({200, 60});
+  b->Args({400, 120});
+}
+
+static Element ScreenContent() {
+  Elements lines;
+  for (int i = 0; i < 120; ++i) {
+    lines.push_back(hbox({
+        text("Line " + std::to_string(i)) | bold,
+        separator(),
+        gauge(float(i % 10) / 10.f) | color(Color::Red),
+        separator(),
+        text("ＨＥＬＬＯ world") | bgcolor(Color::RGB(42, 87, 124)),
+    }));
+  }
+  return vbox(std::move(lines)) | border;
+}
+
+static void BenchmarkScreenClear(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(1));
+  Render(screen, ScreenContent());
+  for (auto _ : state) {
+    screen.Clear();
+  }
+}
+BENCHMARK(BenchmarkScreenClear)->Apply(ScreenSizes);
+
+static void BenchmarkScreenRender(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(1));
+  auto document = ScreenContent();
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+}
+BENCHMARK(BenchmarkScreenRender)->Apply(ScreenSizes);
+
+static void BenchmarkScreenToString(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(1));
+  Render(screen, ScreenContent());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(screen.ToString());
+  }
+}
+BENCHMARK(BenchmarkScreenToString)->Apply(ScreenSizes);
+
+static void BenchmarkScreenToStringReuse(benchmark::State& state) {
+  Screen screen(state.range(0), state.range(1));
+  Render(screen, ScreenContent());
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    screen.ToString(output);
+    benchmark::DoNotOptimize(output);
+  }
+}
+BENCHMARK(BenchmarkScreenToStringReuse)->Apply(ScreenSizes);
+
+// A screen full of CJK and emoji text, whose glyphs are all measured.
+static void BenchmarkScreenToStringCJK(benchmark::State& state) {
+  Elements lines;
+  for (int i = 0; i < 120; ++i) {
+    lines.push_back(text(TextSample(1 + i % 2, 60)));
+  }
+  Screen screen(state.range(0), state.range(1));
+  Render(screen, vbox(std::move(lines)));
+  std::string output;
+  for (auto _ : state) {
+    output.clear();
+    screen.ToString(output);
+    benchmark::DoNotOptimize(output);
+  }
+}
+BENCHMARK(BenchmarkScreenToStringCJK)->Apply(ScreenSizes);
+
+// Nested bordered windows, with automerge enabled on every pixel.
+static void BenchmarkScreenApplyShader(benchmark::State& state) {
+  Elements columns;
+  for (int x = 0; x < 10; ++x) {
+    Elements rows;
+    for (int y = 0; y < 10; ++y) {
+      rows.push_back(hbox({text("cell"), separator(), text("cell")}) | border);
+    }
+    columns.push_back(vbox(std::move(rows)) | border);
+  }
+  auto document = hbox(std::move(columns)) | border | automerge;
+  Screen screen(state.range(0), state.range(1));
+  Render(screen, document);
+  for (auto _ : state) {
+    screen.ApplyShader();
+  }
+}
+BENCHMARK(BenchmarkScreenApplyShader)->Apply(ScreenSizes);
+
+static void BenchmarkStringWidth(benchmark::State& state) {
+  const std::string input = TextSample(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(string_width(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BenchmarkStringWidth)->ArgsProduct({{0, 1, 2}, {1, 100}});
+
+static void BenchmarkUtf8ToGlyphs(benchmark::State& state) {
+  const std::string input = TextSample(state.range(0), state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Utf8ToGlyphs(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BenchmarkUtf8ToGlyphs)->ArgsProduct({{0, 1, 2}, {1, 100}});
+
+// A full screen gradient, as a background. The argument is the terminal color
+// support.
+static void BenchmarkLinearGradient(benchmark::State& state) {
+  const Terminal::Color previous = Terminal::ColorSupport();
+  Terminal::SetColorSupport(Terminal::Color(state.range(0)));
+  auto document = filler() | bgcolor(LinearGradient()
+                                         .Angle(30)
+                                         .Stop(Color::RGB(255, 40, 0))
+                                         .Stop(Color::RGB(20, 200, 80))
+                                         .Stop(Color::RGB(0, 90, 255)));
+  Screen screen(200, 60);
+  for (auto _ : state) {
+    Render(screen, document);
+  }
+  Terminal::SetColorSupport(previous);
+}
+BENCHMARK(BenchmarkLinearGradient)
+    ->Arg(int(Terminal::Color::Palette256))
+    ->Arg(int(Terminal::Color::TrueColor));
+
+// Build RGB colors, for a terminal supporting 16 colors, 256 colors, or
+// TrueColor. The first two quantize every color to the nearest palette entry.
+static void BenchmarkColorRGB(benchmark::State& state) {
+  const Terminal::Color previous = Terminal::ColorSupport();
+  Terminal::SetColorSupport(Terminal::Color(state.range(0)));
+  uint8_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Color::RGB(i, i * 3, i * 7));
+    ++i;
+  }
+  Terminal::SetColorSupport(previous);
+}
+BENCHMARK(BenchmarkColorRGB)
+    ->Arg(int(Terminal::Color::Palette16))
+    ->Arg(int(Terminal::Color::Palette256))
+    ->Arg(int(Terminal::Color::TrueColor));
+
 }  // namespace ftxui
 // NOLINTEND
@@ -1,16 +1,17 @@
 // Copyright 2021 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include "ftxui/dom/arena.hpp"  // for MakeNode
 #include "ftxui/dom/canvas.hpp"
 
 #include <algorithm>               // for max, min
 #include <cmath>                   // for abs
+#include <cstddef>                 // for nullptr_t
 #include <cstdint>                 // for uint8_t
 #include <cstdlib>                 // for abs
 #include <ftxui/screen/color.hpp>  // for Color
 #include <functional>              // for function
-#include <map>                     // for map
-#include <memory>                  // for make_shared
+#include <string>                  // for string
 #include <utility>                 // for move, pair
 #include <vector>                  // for vector
 
@@ -28,10 +29,8 @@ namespace ftxui {
 
 namespace {
 
-// Base UTF8 pattern:
-// 11100010 10100000 10000000 // empty
-
-// Pattern for the individual dots:
+// Pattern for the individual dots, as bits of the braille codepoint offset
+// from U+2800:
 // ┌──────┬───────┐
 // │dot1  │ dot4  │
 // ├──────┼───────┤
@@ -39,48 +38,74 @@ namespace {
 // ├──────┼───────┤
 // │dot3  │ dot6  │
 // ├──────┼───────┤
-// │dot0-1│ dot0-2│
+// │dot7  │ dot8  │
 // └──────┴───────┘
-// 11100010 10100000 10000001 // dot1
-// 11100010 10100000 10000010 // dot2
-// 11100010 10100000 10000100 // dot3
-// 11100010 10100001 10000000 // dot0-1
-// 11100010 10100000 10001000 // dot4
-// 11100010 10100000 10010000 // dot5
-// 11100010 10100000 10100000 // dot6
-// 11100010 10100010 10000000 // dot0-2
-
-// NOLINTNEXTLINE
-uint8_t g_map_braille[2][4][2] = {
+constexpr uint8_t g_map_braille[2][4] = {
     {
-        {0b00000000, 0b00000001},  // NOLINT | dot1
-        {0b00000000, 0b00000010},  // NOLINT | dot2
-        {0b00000000, 0b00000100},  // NOLINT | dot3
-        {0b00000001, 0b00000000},  // NOLINT | dot0-1
+        0b0000'0001,  // dot1
+        0b0000'0010,  // dot2
+        0b0000'0100,  // dot3
+        0b0100'0000,  // dot7
     },
     {
-        {0b00000000, 0b00001000},  // NOLINT | dot4
-        {0b00000000, 0b00010000},  // NOLINT | dot5
-        {0b00000000, 0b00100000},  // NOLINT | dot6
-        {0b00000010, 0b00000000},  // NOLINT | dot0-2
+        0b0000'1000,  // dot4
+        0b0001'0000,  // dot5
+        0b0010'0000,  // dot6
+        0b1000'0000,  // dot8
     },
 };
 
+// UTF8 encoding of the braille pattern U+2800 + |bits|:
+// 11100010 101000xx 10xxxxxx
+void BrailleToUtf8(uint8_t bits, std::string& out) {
+  const char utf8[3] = {
+      char(0b1110'0010),                  // NOLINT
+      char(0b1010'0000 | (bits >> 6)),    // NOLINT
+      char(0b1000'0000 | (bits & 0x3F)),  // NOLINT
+  };
+  out.assign(utf8, 3);
+}
+
 // NOLINTNEXTLINE
 std::vector<std::string> g_map_block = {
     " ", "▘", "▖", "▌", "▝", "▀", "▞", "▛",
     "▗", "▚", "▄", "▙", "▐", "▜", "▟", "█",
 };
 
-// NOLINTNEXTLINE
-const std::map<std::string, uint8_t> g_map_block_inversed = {
-    {" ", 0b0000}, {"▘", 0b0001}, {"▖", 0b0010}, {"▌", 0b0011},
-    {"▝", 0b0100}, {"▀", 0b0101}, {"▞", 0b0110}, {"▛", 0b0111},
-    {"▗", 0b1000}, {"▚", 0b1001}, {"▄", 0b1010}, {"▙", 0b1011},
-    {"▐", 0b1100}, {"▜", 0b1101}, {"▟", 0b1110}, {"█", 0b1111},
-};
+// An empty Stylizer. The cells are drawn without touching their style.
+constexpr std::nullptr_t nostyle = nullptr;
 
-constexpr auto nostyle = [](Pixel& /*pixel*/) {};
+// Rasterize the line from (x1,y1) to (x2,y2) using the Bresenham algorithm.
+// Consecutive dots on the same row are grouped, and reported as
+// |span(x_min, x_max, y)|.
+template <typename Span>
+void ForEachLineSpan(int x1, int y1, int x2, int y2, Span span) {
+  const int dx = std::abs(x2 - x1);
+  const int dy = std::abs(y2 - y1);
+  const int sx = x1 < x2 ? 1 : -1;
+  const int sy = y1 < y2 ? 1 : -1;
+  const int length = std::max(dx, dy);
+
+  int error = dx - dy;
+  int span_x = x1;
+  for (int i = 0; i < length; ++i) {
+    const int x = x1;
+    const int y = y1;
+    if (2 * error >= -dy) {
+      error -= dy;
+      x1 += sx;
+    }
+    if (2 * error <= dx) {
+      error += dx;
+      y1 += sy;
+    }
+    if (y1 != y || i + 1 == length) {
+      span(std::min(span_x, x), std::max(span_x, x), y);
+      span_x = x1;
+    }
+  }
+  span(x2, x2, y2);
+}
 
 }  // namespace
 
@@ -90,14 +115,67 @@ constexpr auto nostyle = [](Pixel& /*pixel*/) {};
 Canvas::Canvas(int width, int height)
     : width_(width),
       height_(height),
-      storage_(width_ * height_ / 8 /* NOLINT */) {}
+      cells_x_((width + 1) / 2),
+      cells_y_((height + 3) / 4),
+      cells_(std::max(0, cells_x_ * cells_y_)) {}
 
 /// @brief Get the content of a cell.
 /// @param x the x coordinate of the cell.
 /// @param y the y coordinate of the cell.
 Pixel Canvas::GetPixel(int x, int y) const {
-  auto it = storage_.find(XY{x, y});
-  return (it == storage_.end()) ? Pixel() : it->second.content;
+  if (x < 0 || x >= cells_x_ || y < 0 || y >= cells_y_) {
+    return {};
+  }
+  const int index = y * cells_x_ + x;
+
+  Pixel pixel;
+  if (!dense_styles_.empty()) {
+    pixel = dense_styles_[index];
+  } else if (!sparse_styles_.empty()) {
+    auto it = sparse_styles_.find(index);
+    if (it != sparse_styles_.end()) {
+      pixel = it->second;
+    }
+  }
+
+  const Cell& cell = cells_[index];
+  switch (cell.type) {
+    case kCell:
+      break;
+    case kBlock:
+      pixel.character = g_map_block[cell.bits];
+      break;
+    case kBraille:
+      BrailleToUtf8(cell.bits, pixel.character);
+      break;
+  }
+  return pixel;
+}
+
+Pixel& Canvas::StyleAt(int index) {
+  if (!dense_styles_.empty()) {
+    return dense_styles_[index];
+  }
+
+  Pixel& pixel = sparse_styles_[index];
+
+  // Switch to the dense storage once a quarter of the cells are styled.
+  if (sparse_styles_.size() * 4 <= cells_.size()) {
+    return pixel;
+  }
+  UseDenseStyles();
+  return dense_styles_[index];
+}
+
+void Canvas::UseDenseStyles() {
+  if (!dense_styles_.empty()) {
+    return;
+  }
+  dense_styles_.resize(cells_.size());
+  for (auto& [i, style] : sparse_styles_) {
+    dense_styles_[i] = std::move(style);
+  }
+  sparse_styles_.clear();
 }
 
 /// @brief Draw a braille dot.
@@ -105,7 +183,7 @@ Pixel Canvas::GetPixel(int x, int y) const {
 /// @param y the y coordinate of the dot.
 /// @param value whether the dot is filled or not.
 void Canvas::DrawPoint(int x, int y, bool value) {
-  DrawPoint(x, y, value, [](Pixel& /*pixel*/) {});
+  DrawPoint(x, y, value, nostyle);
 }
 
 /// @brief Draw a braille dot.
@@ -138,14 +216,13 @@ void Canvas::DrawPointOn(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = cells_[CellIndex(x, y)];
   if (cell.type != CellType::kBraille) {
-    cell.content.character = "⠀";  // 3 bytes.
     cell.type = CellType::kBraille;
+    cell.bits = 0;
   }
 
-  cell.content.character[1] |= g_map_braille[x % 2][y % 4][0];  // NOLINT
-  cell.content.character[2] |= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  cell.bits |= g_map_braille[x % 2][y % 4];  // NOLINT
 }
 
 /// @brief Erase a braille dot.
@@ -155,14 +232,13 @@ void Canvas::DrawPointOff(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = cells_[CellIndex(x, y)];
   if (cell.type != CellType::kBraille) {
-    cell.content.character = "⠀";  // 3 byt
     cell.type = CellType::kBraille;
+    cell.bits = 0;
   }
 
-  cell.content.character[1] &= ~(g_map_braille[x % 2][y % 4][0]);  // NOLINT
-  cell.content.character[2] &= ~(g_map_braille[x % 2][y % 4][1]);  // NOLINT
+  cell.bits &= ~g_map_braille[x % 2][y % 4];  // NOLINT
 }
 
 /// @brief Toggle a braille dot. A filled one will be erased, and the other will
@@ -173,14 +249,13 @@ void Canvas::DrawPointToggle(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = cells_[CellIndex(x, y)];
   if (cell.type != CellType::kBraille) {
-    cell.content.character = "⠀";  // 3 byt
     cell.type = CellType::kBraille;
+    cell.bits = 0;
   }
 
-  cell.content.character[1] ^= g_map_braille[x % 2][y % 4][0];  // NOLINT
-  cell.content.character[2] ^= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  cell.bits ^= g_map_braille[x % 2][y % 4];  // NOLINT
 }
 
 /// @brief Draw a line made of braille dots.
@@ -189,7 +264,7 @@ void Canvas::DrawPointToggle(int x, int y) {
 /// @param x2 the x coordinate of the second dot.
 /// @param y2 the y coordinate of the second dot.
 void Canvas::DrawPointLine(int x1, int y1, int x2, int y2) {
-  DrawPointLine(x1, y1, x2, y2, [](Pixel& /*pixel*/) {});
+  DrawPointLine(x1, y1, x2, y2, nostyle);
 }
 
 /// @brief Draw a line made of braille dots.
@@ -215,10 +290,6 @@ void Canvas::DrawPointLine(int x1,
                            int y2,
                            const Stylizer& style) {
   const int dx = std::abs(x2 - x1);
-  const int dy = std::abs(y2 - y1);
-  const int sx = x1 < x2 ? 1 : -1;
-  const int sy = y1 < y2 ? 1 : -1;
-  const int length = std::max(dx, dy);
 
   if (!IsIn(x1, y1) && !IsIn(x2, y2)) {
     return;
@@ -227,19 +298,9 @@ void Canvas::DrawPointLine(int x1,
     return;
   }
 
-  int error = dx - dy;
-  for (int i = 0; i < length; ++i) {
-    DrawPoint(x1, y1, true, style);
-    if (2 * error >= -dy) {
-      error -= dy;
-      x1 += sx;
-    }
-    if (2 * error <= dx) {
-      error += dx;
-      y1 += sy;
-    }
-  }
-  DrawPoint(x2, y2, true, style);
+  ForEachLineSpan(x1, y1, x2, y2, [&](int x_min, int x_max, int y) {
+    DrawPointSpan(x_min, x_max, y, style);
+  });
 }
 
 /// @brief Draw a circle made of braille dots.
@@ -247,7 +308,7 @@ void Canvas::DrawPointLine(int x1,
 /// @param y the y coordinate of the center of the circle.
 /// @param radius the radius of the circle.
 void Canvas::DrawPointCircle(int x, int y, int radius) {
-  DrawPointCircle(x, y, radius, [](Pixel& /*pixel*/) {});
+  DrawPointCircle(x, y, radius, nostyle);
 }
 
 /// @brief Draw a circle made of braille dots.
@@ -274,7 +335,7 @@ void Canvas::DrawPointCircle(int x, int y, int radius, const Stylizer& style) {
 /// @param y the y coordinate of the center of the circle.
 /// @param radius the radius of the circle.
 void Canvas::DrawPointCircleFilled(int x, int y, int radius) {
-  DrawPointCircleFilled(x, y, radius, [](Pixel& /*pixel*/) {});
+  DrawPointCircleFilled(x, y, radius, nostyle);
 }
 
 /// @brief Draw a filled circle made of braille dots.
@@ -308,7 +369,7 @@ void Canvas::DrawPointCircleFilled(int x,
 /// @param r1 the radius of the ellipse along the x axis.
 /// @param r2 the radius of the ellipse along the y axis.
 void Canvas::DrawPointEllipse(int x, int y, int r1, int r2) {
-  DrawPointEllipse(x, y, r1, r2, [](Pixel& /*pixel*/) {});
+  DrawPointEllipse(x, y, r1, r2, nostyle);
 }
 
 /// @brief Draw an ellipse made of braille dots.
@@ -372,7 +433,7 @@ void Canvas::DrawPointEllipse(int x1,
 /// @param r1 the radius of the ellipse along the x axis.
 /// @param r2 the radius of the ellipse along the y axis.
 void Canvas::DrawPointEllipseFilled(int x1, int y1, int r1, int r2) {
-  DrawPointEllipseFilled(x1, y1, r1, r2, [](Pixel& /*pixel*/) {});
+  DrawPointEllipseFilled(x1, y1, r1, r2, nostyle);
 }
 
 /// @brief Draw a filled ellipse made of braille dots.
@@ -409,10 +470,8 @@ void Canvas::DrawPointEllipseFilled(int x1,
   int err = dx + dy;
 
   do {  // NOLINT
-    for (int xx = x1 + x; xx <= x1 - x; ++xx) {
-      DrawPoint(xx, y1 + y, true, s);
-      DrawPoint(xx, y1 - y, true, s);
-    }
+    DrawPointSpan(x1 + x, x1 - x, y1 + y, s);
+    DrawPointSpan(x1 + x, x1 - x, y1 - y, s);
     e2 = 2 * err;
     if (e2 >= dx) {
       x++;
@@ -431,12 +490,112 @@ void Canvas::DrawPointEllipseFilled(int x1,
   }
 }
 
+/// @brief Draw a set of braille dots.
+/// @param points the coordinates of the dots.
+void Canvas::DrawPoints(const std::vector<Point>& points) {
+  for (const Point& point : points) {
+    if (!IsIn(point.x, point.y)) {
+      continue;
+    }
+    Cell& cell = cells_[CellIndex(point.x, point.y)];
+    const uint8_t bits = cell.type == CellType::kBraille ? cell.bits : 0;
+    cell.bits = bits | g_map_braille[point.x % 2][point.y % 4];  // NOLINT
+    cell.type = CellType::kBraille;
+  }
+}
+
+/// @brief Draw a set of braille dots.
+/// @param points the coordinates of the dots.
+/// @param color the color of the dots.
+void Canvas::DrawPoints(const std::vector<Point>& points, const Color& color) {
+  if (points.size() * 4 > cells_.size()) {
+    UseDenseStyles();
+  }
+  for (const Point& point : points) {
+    if (!IsIn(point.x, point.y)) {
+      continue;
+    }
+    const int index = CellIndex(point.x, point.y);
+    Cell& cell = cells_[index];
+    const uint8_t bits = cell.type == CellType::kBraille ? cell.bits : 0;
+    cell.bits = bits | g_map_braille[point.x % 2][point.y % 4];  // NOLINT
+    cell.type = CellType::kBraille;
+    StyleAt(index).foreground_color = color;
+  }
+}
+
+void Canvas::DrawPointSpan(int x_min,
+                           int x_max,
+                           int y,
+                           const Stylizer& style) {
+  if (y < 0 || y >= height_) {
+    return;
+  }
+  x_min = std::max(x_min, 0);
+  x_max = std::min(x_max, width_ - 1);
+  if (x_min > x_max) {
+    return;
+  }
+
+  // The dots of the row, in the left and right column of a cell.
+  const uint8_t left = g_map_braille[0][y % 4];   // NOLINT
+  const uint8_t right = g_map_braille[1][y % 4];  // NOLINT
+  const int row = (y / 4) * cells_x_;
+  for (int x = x_min / 2; x <= x_max / 2; ++x) {
+    uint8_t bits = 0;
+    bits |= (2 * x >= x_min) ? left : 0;
+    bits |= (2 * x + 1 <= x_max) ? right : 0;
+    Cell& cell = cells_[row + x];
+    cell.bits = (cell.type == CellType::kBraille ? cell.bits : 0) | bits;
+    cell.type = CellType::kBraille;
+  }
+
+  if (style) {
+    for (int x = x_min / 2; x <= x_max / 2; ++x) {
+      style(StyleAt(row + x));
+    }
+  }
+}
+
+void Canvas::DrawBlockSpan(int x_min,
+                           int x_max,
+                           int y,
+                           const Stylizer& style) {
+  if (y < 0 || y >= height_) {
+    return;
+  }
+  x_min = std::max(x_min, 0);
+  x_max = std::min(x_max, width_ - 1);
+  if (x_min > x_max) {
+    return;
+  }
+
+  // The blocks of the row, in the left and right column of a cell.
+  const uint8_t left = 1U << ((y / 2) % 2);
+  const uint8_t right = 1U << (2 + (y / 2) % 2);
+  const int row = (y / 4) * cells_x_;
+  for (int x = x_min / 2; x <= x_max / 2; ++x) {
+    uint8_t bits = 0;
+    bits |= (2 * x >= x_min) ? left : 0;
+    bits |= (2 * x + 1 <= x_max) ? right : 0;
+    Cell& cell = cells_[row + x];
+    cell.bits = (cell.type == CellType::kBlock ? cell.bits : 0) | bits;
+    cell.type = CellType::kBlock;
+  }
+
+  if (style) {
+    for (int x = x_min / 2; x <= x_max / 2; ++x) {
+      style(StyleAt(row + x));
+    }
+  }
+}
+
 /// @brief Draw a block.
 /// @param x the x coordinate of the block.
 /// @param y the y coordinate of the block.
 /// @param value whether the block is filled or not.
 void Canvas::DrawBlock(int x, int y, bool value) {
-  DrawBlock(x, y, value, [](Pixel& /*pixel*/) {});
+  DrawBlock(x, y, value, nostyle);
 }
 
 /// @brief Draw a block.
@@ -469,17 +628,15 @@ void Canvas::DrawBlockOn(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  y /= 2;
-  Cell& cell = storage_[XY{x / 2, y / 2}];
+  Cell& cell = cells_[CellIndex(x, y)];
   if (cell.type != CellType::kBlock) {
-    cell.content.character = " ";
     cell.type = CellType::kBlock;
+    cell.bits = 0;
   }
+  y /= 2;
 
   const uint8_t bit = (x % 2) * 2 + y % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
-  value |= 1U << bit;
-  cell.content.character = g_map_block[value];
+  cell.bits |= 1U << bit;
 }
 
 /// @brief Erase a block.
@@ -489,17 +646,15 @@ void Canvas::DrawBlockOff(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = cells_[CellIndex(x, y)];
   if (cell.type != CellType::kBlock) {
-    cell.content.character = " ";
     cell.type = CellType::kBlock;
+    cell.bits = 0;
   }
   y /= 2;
 
   const uint8_t bit = (y % 2) * 2 + x % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
-  value &= ~(1U << bit);
-  cell.content.character = g_map_block[value];
+  cell.bits &= ~(1U << bit);
 }
 
 /// @brief Toggle a block. If it is filled, it will be erased. If it is empty,
@@ -510,17 +665,15 @@ void Canvas::DrawBlockToggle(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
+  Cell& cell = cells_[CellIndex(x, y)];
   if (cell.type != CellType::kBlock) {
-    cell.content.character = " ";
     cell.type = CellType::kBlock;
+    cell.bits = 0;
   }
   y /= 2;
 
   const uint8_t bit = (y % 2) * 2 + x % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
-  value ^= 1U << bit;
-  cell.content.character = g_map_block[value];
+  cell.bits ^= 1U << bit;
 }
 
 /// @brief Draw a line made of block characters.
@@ -529,7 +682,7 @@ void Canvas::DrawBlockToggle(int x, int y) {
 /// @param x2 the x coordinate of the second point of the line.
 /// @param y2 the y coordinate of the second point of the line.
 void Canvas::DrawBlockLine(int x1, int y1, int x2, int y2) {
-  DrawBlockLine(x1, y1, x2, y2, [](Pixel& /*pixel*/) {});
+  DrawBlockLine(x1, y1, x2, y2, nostyle);
 }
 
 /// @brief Draw a line made of block characters.
@@ -558,10 +711,6 @@ void Canvas::DrawBlockLine(int x1,
   y2 /= 2;
 
   const int dx = std::abs(x2 - x1);
-  const int dy = std::abs(y2 - y1);
-  const int sx = x1 < x2 ? 1 : -1;
-  const int sy = y1 < y2 ? 1 : -1;
-  const int length = std::max(dx, dy);
 
   if (!IsIn(x1, y1) && !IsIn(x2, y2)) {
     return;
@@ -570,19 +719,9 @@ void Canvas::DrawBlockLine(int x1,
     return;
   }
 
-  int error = dx - dy;
-  for (int i = 0; i < length; ++i) {
-    DrawBlock(x1, y1 * 2, true, style);
-    if (2 * error >= -dy) {
-      error -= dy;
-      x1 += sx;
-    }
-    if (2 * error <= dx) {
-      error += dx;
-      y1 += sy;
-    }
-  }
-  DrawBlock(x2, y2 * 2, true, style);
+  ForEachLineSpan(x1, y1, x2, y2, [&](int x_min, int x_max, int y) {
+    DrawBlockSpan(x_min, x_max, 2 * y, style);
+  });
 }
 
 /// @brief Draw a circle made of block characters.
@@ -756,10 +895,8 @@ void Canvas::DrawBlockEllipseFilled(int x1,
   int err = dx + dy;
 
   do {  // NOLINT
-    for (int xx = x1 + x; xx <= x1 - x; ++xx) {
-      DrawBlock(xx, 2 * (y1 + y), true, s);
-      DrawBlock(xx, 2 * (y1 - y), true, s);
-    }
+    DrawBlockSpan(x1 + x, x1 - x, 2 * (y1 + y), s);
+    DrawBlockSpan(x1 + x, x1 - x, 2 * (y1 - y), s);
     e2 = 2 * err;
     if (e2 >= dx) {
       x++;
@@ -812,10 +949,13 @@ void Canvas::DrawText(int x,
       x += 2;
       continue;
     }
-    Cell& cell = storage_[XY{x / 2, y / 4}];
-    cell.type = CellType::kCell;
-    cell.content.character = it;
-    style(cell.content);
+    const int index = CellIndex(x, y);
+    cells_[index].type = CellType::kCell;
+    Pixel& pixel = StyleAt(index);
+    pixel.character = it;
+    if (style) {
+      style(pixel);
+    }
     x += 2;
   }
 }
@@ -825,9 +965,12 @@ void Canvas::DrawText(int x,
 /// @param y the y coordinate of the pixel.
 /// @param p the pixel to draw.
 void Canvas::DrawPixel(int x, int y, const Pixel& p) {
-  Cell& cell = storage_[XY{x / 2, y / 4}];
-  cell.type = CellType::kCell;
-  cell.content = p;
+  if (!IsIn(x, y)) {
+    return;
+  }
+  const int index = CellIndex(x, y);
+  cells_[index].type = CellType::kCell;
+  StyleAt(index) = p;
 }
 
 /// @brief Draw a predefined image, with top-left corner at the given coordinate
@@ -841,17 +984,14 @@ void Canvas::DrawImage(int x, int y, const Image& image) {
   y /= 4;
   const int dx_begin = std::max(0, -x);
   const int dy_begin = std::max(0, -y);
-  const int dx_end = std::min(image.dimx(), width_ - x);
-  const int dy_end = std::min(image.dimy(), height_ - y);
+  const int dx_end = std::min(image.dimx(), cells_x_ - x);
+  const int dy_end = std::min(image.dimy(), cells_y_ - y);
 
   for (int dy = dy_begin; dy < dy_end; ++dy) {
     for (int dx = dx_begin; dx < dx_end; ++dx) {
-      Cell& cell = storage_[XY{
-          x + dx,
-          y + dy,
-      }];
-      cell.type = CellType::kCell;
-      cell.content = image.PixelAt(dx, dy);
+      const int index = (y + dy) * cells_x_ + x + dx;
+      cells_[index].type = CellType::kCell;
+      StyleAt(index) = image.PixelAt(dx, dy);
     }
   }
 }
@@ -859,11 +999,89 @@ void Canvas::DrawImage(int x, int y, const Image& image) {
 /// @brief Modify a pixel at a given location.
 /// @param style a function that modifies the pixel.
 void Canvas::Style(int x, int y, const Stylizer& style) {
-  if (IsIn(x, y)) {
-    style(storage_[XY{x / 2, y / 4}].content);
+  if (style && IsIn(x, y)) {
+    style(StyleAt(CellIndex(x, y)));
   }
 }
 
+/// @brief Move the whole content of the canvas. The cells uncovered are
+/// cleared, the ones moved outside are lost.
+/// @param dx the horizontal offset. It is considered to be a multiple of 2.
+/// @param dy the vertical offset. It is considered to be a multiple of 4.
+void Canvas::Scroll(int dx, int dy) {
+  dx /= 2;
+  dy /= 4;
+  if (dx == 0 && dy == 0) {
+    return;
+  }
+
+  // Return the index of the cell moved to |index|, or -1.
+  auto source = [&](int index) {
+    const int x = index % cells_x_ - dx;
+    const int y = index / cells_x_ - dy;
+    if (x < 0 || x >= cells_x_ || y < 0 || y >= cells_y_) {
+      return -1;
+    }
+    return y * cells_x_ + x;
+  };
+
+  std::vector<Cell> cells(cells_.size());
+  for (int i = 0; i < int(cells.size()); ++i) {
+    const int j = source(i);
+    if (j >= 0) {
+      cells[i] = cells_[j];
+    }
+  }
+  cells_ = std::move(cells);
+
+  if (!dense_styles_.empty()) {
+    std::vector<Pixel> styles(dense_styles_.size());
+    for (int i = 0; i < int(styles.size()); ++i) {
+      const int j = source(i);
+      if (j >= 0) {
+        styles[i] = std::move(dense_styles_[j]);
+      }
+    }
+    dense_styles_ = std::move(styles);
+    return;
+  }
+
+  std::unordered_map<int, Pixel> styles;
+  for (auto& [j, style] : sparse_styles_) {
+    const int x = j % cells_x_ + dx;
+    const int y = j / cells_x_ + dy;
+    if (x >= 0 && x < cells_x_ && y >= 0 && y < cells_y_) {
+      styles[y * cells_x_ + x] = std::move(style);
+    }
+  }
+  sparse_styles_ = std::move(styles);
+}
+
+/// @brief Constructor.
+/// @param draw the function drawing the whole canvas. It is called with a
+/// blank canvas.
+RetainedCanvas::RetainedCanvas(std::function<void(Canvas&)> draw)
+    : draw_(std::move(draw)) {}
+
+/// @brief Return a canvas of the given size. The draw function is called only
+/// if the size or the version changed since the previous draw.
+/// @param width the width of the canvas, in braille dots.
+/// @param height the height of the canvas, in braille dots.
+const Canvas& RetainedCanvas::Update(int width, int height) {
+  if (draw_count_ != 0 && drawn_version_ == version_ &&
+      canvas_.width() == width && canvas_.height() == height) {
+    return canvas_;
+  }
+
+  canvas_ = Canvas(width, height);
+  if (draw_) {
+    draw_(canvas_);
+  }
+  drawn_version_ = version_;
+  ++draw_count_;
+  return canvas_;
+}
+
 namespace {
 
 class CanvasNodeBase : public Node {
@@ -898,7 +1116,7 @@ Element canvas(ConstRef<Canvas> canvas) {
     const Canvas& canvas() final { return *canvas_; }
     ConstRef<Canvas> canvas_;
   };
-  return std::make_shared<Impl>(canvas);
+  return MakeNode<Impl>(canvas);
 }
 
 /// @brief Produce an element drawing a canvas of requested size.
@@ -930,7 +1148,7 @@ Element canvas(int width, int height, std::function<void(Canvas&)> fn) {
     int height_;
     std::function<void(Canvas&)> fn_;
   };
-  return std::make_shared<Impl>(width, height, std::move(fn));
+  return MakeNode<Impl>(width, height, std::move(fn));
 }
 
 /// @brief Produce an element drawing a canvas.
@@ -940,4 +1158,45 @@ Element canvas(std::function<void(Canvas&)> fn) {
   return canvas(default_dim, default_dim, std::move(fn));
 }
 
+/// @brief Display a canvas kept in between frames. Its draw function is only
+/// called when the size of the element or the version changes.
+/// @param width the requested width of the canvas, in braille dots.
+/// @param height the requested height of the canvas, in braille dots.
+/// @param retained the canvas. It must outlive the element.
+/// @see RetainedCanvas
+/// @ingroup dom
+Element canvas(int width, int height, RetainedCanvas* retained) {
+  class Impl : public CanvasNodeBase {
+   public:
+    Impl(int width, int height, RetainedCanvas* retained)
+        : width_(width), height_(height), retained_(retained) {}
+
+    void ComputeRequirement() final {
+      requirement_.min_x = (width_ + 1) / 2;
+      requirement_.min_y = (height_ + 3) / 4;
+    }
+
+    const Canvas& canvas() final {
+      const int width = (box_.x_max - box_.x_min + 1) * 2;
+      const int height = (box_.y_max - box_.y_min + 1) * 4;
+      return retained_->Update(width, height);
+    }
+
+    int width_;
+    int height_;
+    RetainedCanvas* retained_;
+  };
+  return MakeNode<Impl>(width, height, retained);
+}
+
+/// @brief Display a canvas kept in between frames. Its draw function is only
+/// called when the size of the element or the version changes.
+/// @param retained the canvas. It must outlive the element.
+/// @see RetainedCanvas
+/// @ingroup dom
+Element canvas(RetainedCanvas* retained) {
+  const int default_dim = 12;
+  return canvas(default_dim, default_dim, retained);
+}
+
 }  // namespace ftxui
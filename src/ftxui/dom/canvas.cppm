@@ -13,4 +13,5 @@ export module ftxui.dom.canvas;
  */
 export namespace ftxui {
     using ftxui::Canvas;
+    using ftxui::RetainedCanvas;
 }
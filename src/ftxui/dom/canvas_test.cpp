@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 #include <cstdint>  // for uint32_t
 #include <string>   // for allocator, string
+#include <vector>   // for vector
 
 #include "ftxui/dom/canvas.hpp"    // for Canvas
 #include "ftxui/dom/elements.hpp"  // for canvas
@@ -104,5 +105,103 @@ TEST(CanvasTest, GoldText) {
   EXPECT_EQ(Hash(screen.ToString()), 1074960375);
 }
 
+// Styling most of the cells switches to the dense style storage. This must
+// not change the content.
+TEST(CanvasTest, StyleManyCells) {
+  Canvas c(20, 20);
+  c.DrawText(0, 0, "a", Color::Red);
+  for (int x = 2; x < 20; ++x) {
+    c.DrawPoint(x, 4, true, Color::Blue);
+  }
+  c.DrawBlock(0, 8, true);
+
+  EXPECT_EQ(c.GetPixel(0, 0).character, "a");
+  EXPECT_EQ(c.GetPixel(0, 0).foreground_color, Color(Color::Red));
+  EXPECT_EQ(c.GetPixel(1, 1).character, "⠉");
+  EXPECT_EQ(c.GetPixel(1, 1).foreground_color, Color(Color::Blue));
+  EXPECT_EQ(c.GetPixel(0, 2).character, "▘");
+  EXPECT_EQ(c.GetPixel(0, 2).foreground_color, Color(Color::Default));
+  EXPECT_EQ(c.GetPixel(4, 4).character, "");
+  EXPECT_EQ(c.GetPixel(10, 0).character, "");
+}
+
+TEST(CanvasTest, DrawPoints) {
+  std::vector<Canvas::Point> points;
+  for (int i = -5; i < 50; ++i) {
+    points.push_back({i, (i * 7) % 23});
+  }
+
+  Canvas expected(40, 20);
+  Canvas actual(40, 20);
+  for (const auto& point : points) {
+    expected.DrawPoint(point.x, point.y, true, Color::Red);
+  }
+  actual.DrawPoints(points, Color::Red);
+
+  for (int y = 0; y < 5; ++y) {
+    for (int x = 0; x < 20; ++x) {
+      EXPECT_EQ(actual.GetPixel(x, y).character,
+                expected.GetPixel(x, y).character);
+      EXPECT_EQ(actual.GetPixel(x, y).foreground_color,
+                expected.GetPixel(x, y).foreground_color);
+    }
+  }
+}
+
+TEST(CanvasTest, Scroll) {
+  Canvas c(6, 8);
+  c.DrawText(0, 0, "a");
+  c.DrawPoint(2, 4, true, Color::Red);
+
+  c.Scroll(2, 0);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "");
+  EXPECT_EQ(c.GetPixel(1, 0).character, "a");
+  EXPECT_EQ(c.GetPixel(1, 1).character, "");
+  EXPECT_EQ(c.GetPixel(2, 1).character, "⠁");
+  EXPECT_EQ(c.GetPixel(2, 1).foreground_color, Color(Color::Red));
+
+  c.Scroll(-4, -4);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "⠁");
+  EXPECT_EQ(c.GetPixel(0, 0).foreground_color, Color(Color::Red));
+  EXPECT_EQ(c.GetPixel(1, 0).character, "");
+  EXPECT_EQ(c.GetPixel(0, 1).character, "");
+}
+
+TEST(CanvasTest, RetainedCanvas) {
+  int value = 0;
+  RetainedCanvas retained([&](Canvas& c) {
+    c.DrawText(0, 0, std::to_string(value));
+  });
+  auto render = [&](int width) {
+    Screen screen(width, 1);
+    Render(screen, canvas(&retained));
+    return screen.ToString();
+  };
+
+  EXPECT_EQ(render(2), "0 ");
+  EXPECT_EQ(retained.draw_count(), 1);
+
+  // Same version and size: the previous canvas is reused.
+  value = 1;
+  EXPECT_EQ(render(2), "0 ");
+  EXPECT_EQ(retained.draw_count(), 1);
+
+  // New version:
+  retained.SetVersion(1);
+  EXPECT_EQ(render(2), "1 ");
+  EXPECT_EQ(retained.draw_count(), 2);
+
+  // New size:
+  value = 2;
+  EXPECT_EQ(render(3), "2  ");
+  EXPECT_EQ(retained.draw_count(), 3);
+
+  // Incremental update:
+  retained.canvas().Scroll(2, 0);
+  retained.canvas().DrawText(0, 0, "x");
+  EXPECT_EQ(render(3), "x2 ");
+  EXPECT_EQ(retained.draw_count(), 3);
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -3,10 +3,11 @@
 // the LICENSE file.
 #include <algorithm>  // for max
 #include <cstddef>    // for size_t
-#include <memory>     // for __shared_ptr_access, shared_ptr, make_shared
+#include <memory>     // for __shared_ptr_access, shared_ptr
 #include <utility>    // for move
 #include <vector>
 
+#include "ftxui/dom/arena.hpp"        // for MakeNode
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, dbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
 #include "ftxui/dom/requirement.hpp"  // for Requirement
@@ -23,7 +24,7 @@ class DBox : public Node {
   void ComputeRequirement() override {
     requirement_ = Requirement{};
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      child->CachedComputeRequirement();
 
       // Propagate the focused requirement.
       if (requirement_.focused.Prefer(child->requirement().focused)) {
@@ -42,7 +43,7 @@ class DBox : public Node {
     Node::SetBox(box);
 
     for (auto& child : children_) {
-      child->SetBox(box);
+      child->CachedSetBox(box);
     }
   }
 };
@@ -53,7 +54,7 @@ class DBox : public Node {
 /// @return The right aligned element.
 /// @ingroup dom
 Element dbox(Elements children_) {
-  return std::make_shared<DBox>(std::move(children_));
+  return MakeNode<DBox>(std::move(children_));
 }
 
 }  // namespace ftxui
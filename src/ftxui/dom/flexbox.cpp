@@ -3,11 +3,13 @@
 // the LICENSE file.
 #include <algorithm>  // for min, max
 #include <cstddef>    // for size_t
-#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type, make_shared
+#include <limits>     // for numeric_limits
+#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type
 #include <tuple>   // for ignore
 #include <utility>  // for move, swap
 #include <vector>   // for vector
 
+#include "ftxui/dom/arena.hpp"     // for MakeNode
 #include "ftxui/dom/elements.hpp"  // for Element, Elements, flexbox, hflow, vflow
 #include "ftxui/dom/flexbox_config.hpp"  // for FlexboxConfig, FlexboxConfig::Direction, FlexboxConfig::Direction::Column, FlexboxConfig::AlignContent, FlexboxConfig::Direction::ColumnInversed, FlexboxConfig::Direction::Row, FlexboxConfig::JustifyContent, FlexboxConfig::Wrap, FlexboxConfig::AlignContent::FlexStart, FlexboxConfig::Direction::RowInversed, FlexboxConfig::JustifyContent::FlexStart, FlexboxConfig::Wrap::Wrap
 #include "ftxui/dom/flexbox_helper.hpp"  // for Block, Global, Compute
@@ -64,6 +66,12 @@ class Flexbox : public Node {
     if (IsColumnOriented()) {
       std::swap(requirement_.flex_grow_x, requirement_.flex_grow_y);
     }
+
+    global_.config = config_normalized_;
+    global_box_.config = config_;
+    global_.size_x = global_.size_y = -1;
+    global_box_.size_x = global_box_.size_y = -1;
+    box_previous_.x_min = std::numeric_limits<int>::min();
   }
 
   bool IsColumnOriented() const {
@@ -71,18 +79,45 @@ class Flexbox : public Node {
            config_.direction == FlexboxConfig::Direction::ColumnInversed;
   }
 
+  // Lay out the children into |global|, for a container of the given size.
+  // The previous result, including the line breaks, is kept when neither the
+  // size nor the children requirements changed.
   void Layout(flexbox_helper::Global& global,
+              int size_x,
+              int size_y,
               bool compute_requirement = false) {
+    bool unchanged = global.size_x == size_x && global.size_y == size_y &&
+                     global.blocks.size() == children_.size();
+    for (size_t i = 0; unchanged && i < children_.size(); ++i) {
+      const flexbox_helper::Block& block = global.blocks[i];
+      const Requirement r = children_[i]->requirement();
+      unchanged = block.min_size_x == r.min_x &&  //
+                  block.min_size_y == r.min_y &&  //
+                  (compute_requirement ||         //
+                   (block.flex_grow_x == r.flex_grow_x &&
+                    block.flex_grow_y == r.flex_grow_y &&
+                    block.flex_shrink_x == r.flex_shrink_x &&
+                    block.flex_shrink_y == r.flex_shrink_y));
+    }
+    if (unchanged) {
+      return;
+    }
+
+    global.size_x = size_x;
+    global.size_y = size_y;
+    global.lines.clear();
+    global.blocks.clear();
     global.blocks.reserve(children_.size());
     for (auto& child : children_) {
+      const Requirement r = child->requirement();
       flexbox_helper::Block block;
-      block.min_size_x = child->requirement().min_x;
-      block.min_size_y = child->requirement().min_y;
+      block.min_size_x = r.min_x;
+      block.min_size_y = r.min_y;
       if (!compute_requirement) {
-        block.flex_grow_x = child->requirement().flex_grow_x;
-        block.flex_grow_y = child->requirement().flex_grow_y;
-        block.flex_shrink_x = child->requirement().flex_shrink_x;
-        block.flex_shrink_y = child->requirement().flex_shrink_y;
+        block.flex_grow_x = r.flex_grow_x;
+        block.flex_grow_y = r.flex_grow_y;
+        block.flex_shrink_x = r.flex_shrink_x;
+        block.flex_shrink_y = r.flex_shrink_y;
       }
       global.blocks.push_back(block);
     }
@@ -93,18 +128,13 @@ class Flexbox : public Node {
   void ComputeRequirement() override {
     requirement_ = Requirement{};
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      child->CachedComputeRequirement();
     }
-    global_ = flexbox_helper::Global();
-    global_.config = config_normalized_;
     if (IsColumnOriented()) {
-      global_.size_x = 100000;  // NOLINT
-      global_.size_y = asked_;
+      Layout(global_, 100000, asked_, true);  // NOLINT
     } else {
-      global_.size_x = asked_;
-      global_.size_y = 100000;  // NOLINT
+      Layout(global_, asked_, 100000, true);  // NOLINT
     }
-    Layout(global_, true);
 
     if (global_.blocks.empty()) {
       return;
@@ -141,20 +171,30 @@ class Flexbox : public Node {
   void SetBox(Box box) override {
     Node::SetBox(box);
 
+    const int size = IsColumnOriented() ? box.y_max - box.y_min + 1
+                                        : box.x_max - box.x_min + 1;
     const int asked_previous = asked_;
-    asked_ = std::min(asked_, IsColumnOriented() ? box.y_max - box.y_min + 1
-                                                 : box.x_max - box.x_min + 1);
+    const bool box_changed = (box != box_previous_);
+    box_previous_ = box;
+
+    if (first_set_box_ && box_changed && asked_ != kAskedMax) {
+      // The size negotiated during the previous frame was for a different
+      // box. Start over the negotiation from scratch.
+      asked_ = kAskedMax;
+    } else {
+      asked_ = std::min(asked_, size);
+    }
+    first_set_box_ = false;
+
+    // Another iteration is needed if the size changed, or when the children
+    // are clipped by a new box, in case the parent gives more space.
     need_iteration_ = (asked_ != asked_previous);
 
-    flexbox_helper::Global global;
-    global.config = config_;
-    global.size_x = box.x_max - box.x_min + 1;
-    global.size_y = box.y_max - box.y_min + 1;
-    Layout(global);
+    Layout(global_box_, box.x_max - box.x_min + 1, box.y_max - box.y_min + 1);
 
     for (size_t i = 0; i < children_.size(); ++i) {
       auto& child = children_[i];
-      auto& b = global.blocks[i];
+      auto& b = global_box_.blocks[i];
 
       Box children_box;
       children_box.x_min = box.x_min + b.x;
@@ -163,9 +203,9 @@ class Flexbox : public Node {
       children_box.y_max = box.y_min + b.y + b.dim_y - 1;
 
       const Box intersection = Box::Intersection(children_box, box);
-      child->SetBox(intersection);
+      child->CachedSetBox(intersection);
 
-      need_iteration_ |= (intersection != children_box);
+      need_iteration_ |= (intersection != children_box) && box_changed;
     }
   }
 
@@ -208,22 +248,32 @@ class Flexbox : public Node {
 
   void Check(Status* status) override {
     for (auto& child : children_) {
-      child->Check(status);
+      child->CachedCheck(status);
     }
 
+    // When the screen size didn't change, the size negotiated during the
+    // previous frame is kept as a starting point. If the box didn't change
+    // either, the layout converges in one pass.
     if (status->iteration == 0) {
-      asked_ = 6000;  // NOLINT
+      if (!status->same_box) {
+        asked_ = kAskedMax;
+      }
+      first_set_box_ = true;
       need_iteration_ = true;
     }
 
     status->need_iteration |= need_iteration_;
   }
 
-  int asked_ = 6000;  // NOLINT
+  static constexpr int kAskedMax = 6000;
+  int asked_ = kAskedMax;
   bool need_iteration_ = true;
+  bool first_set_box_ = true;
+  Box box_previous_;
   const FlexboxConfig config_;
   const FlexboxConfig config_normalized_;
-  flexbox_helper::Global global_;
+  flexbox_helper::Global global_;      // Used to compute the requirement.
+  flexbox_helper::Global global_box_;  // Used to compute the children boxes.
 };
 
 }  // namespace
@@ -249,7 +299,7 @@ class Flexbox : public Node {
 /// )
 /// ```
 Element flexbox(Elements children, FlexboxConfig config) {
-  return std::make_shared<Flexbox>(std::move(children), config);
+  return MakeNode<Flexbox>(std::move(children), config);
 }
 
 /// @brief A container displaying elements in rows from left to right. When
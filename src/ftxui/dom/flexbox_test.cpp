@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>
+#include <memory>  // for make_shared
 #include <string>  // for allocator
 
 #include "ftxui/dom/elements.hpp"        // for text, flexbox
@@ -12,6 +13,32 @@
 // NOLINTBEGIN
 namespace ftxui {
 
+namespace {
+// A leaf counting how many times the layout visits it.
+class LayoutCounter : public Node {
+ public:
+  explicit LayoutCounter(int* count) : count_(count) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = 3;
+    requirement_.min_y = 1;
+    ++*count_;
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    ++*count_;
+  }
+
+  void Render(Screen& screen) override {
+    screen.PixelAt(box_.x_min, box_.y_min).character = "x";
+  }
+
+ private:
+  int* count_;
+};
+}  // namespace
+
 TEST(FlexboxTest, BasicRow) {
   auto root = flexbox(
       {
@@ -457,5 +484,59 @@ TEST(FlexboxTest, Focus) {
             "-");
 }
 
+TEST(FlexboxTest, LayoutCaching) {
+  int count = 0;
+  auto document = vbox({
+      hbox({
+          std::make_shared<LayoutCounter>(&count),
+          std::make_shared<LayoutCounter>(&count),
+      }),
+      paragraph("a b c d e f"),
+      std::make_shared<LayoutCounter>(&count),
+  });
+
+  // The paragraph requires a second iteration of the layout. The other elements
+  // are not visited again, except the last one, moved below the paragraph.
+  Screen screen(5, 6);
+  Render(screen, document);
+  EXPECT_EQ(count, 3 + 3 + 1);
+  EXPECT_EQ(screen.ToString(),
+            "x  x \r\n"
+            "a b c\r\n"
+            "d e f\r\n"
+            "x    \r\n"
+            "     \r\n"
+            "     ");
+
+  // The next frame starts from the size negotiated by the paragraph, and
+  // converges in a single iteration.
+  count = 0;
+  Render(screen, document);
+  EXPECT_EQ(count, 3 + 3);
+}
+
+TEST(FlexboxTest, LayoutReusedInBetweenFrames) {
+  auto make_document = [] {
+    return vbox({
+        hbox({
+            paragraph("a bb ccc dddd eeeee") | border,
+            paragraph("ff ggg hhhh i j k") | flex,
+        }),
+        paragraph("lorem ipsum dolor sit amet"),
+    });
+  };
+
+  // Resizing a document kept in between frames gives the same result as
+  // rendering a new one.
+  auto document = make_document();
+  for (int width : {20, 20, 12, 30, 5, 30, 30}) {
+    Screen reused(width, 10);
+    Render(reused, document);
+    Screen fresh(width, 10);
+    Render(fresh, make_document());
+    EXPECT_EQ(reused.ToString(), fresh.ToString()) << "width: " << width;
+  }
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -1,16 +1,20 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max, min
+#include <algorithm>  // for max, min, fill
 #include <cstddef>    // for size_t
-#include <memory>  // for __shared_ptr_access, shared_ptr, make_shared, allocator_traits<>::value_type
+#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type
+#include <string>   // for string
 #include <utility>  // for move
 #include <vector>   // for vector, __alloc_traits<>::value_type
 
+#include "ftxui/dom/arena.hpp"        // for MakeNode
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
 #include "ftxui/dom/elements.hpp"     // for Elements, filler, Element, gridbox
 #include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/render_pool.hpp"  // for RenderPool
 #include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/dom/selection.hpp"    // for Selection
 #include "ftxui/screen/box.hpp"       // for Box
 
 namespace ftxui {
@@ -46,101 +50,244 @@ class GridBox : public Node {
         line.push_back(filler());
       }
     }
+
+    cells_.resize(size_t(x_size) * size_t(y_size));
+    columns_.resize(x_size);
+    rows_.resize(y_size);
+    column_changed_.resize(x_size, true);
+    row_changed_.resize(y_size, true);
   }
 
   void ComputeRequirement() override {
     requirement_ = Requirement{};
-    for (auto& line : lines_) {
-      for (auto& cell : line) {
-        cell->ComputeRequirement();
+
+    // Collect the requirement of every cell, in storage order. Track the
+    // columns and rows whose cells changed.
+    int focused_x = x_size;
+    int focused_y = y_size;
+    Requirement::Focused focused;
+    size_t i = 0;
+    for (int y = 0; y < y_size; ++y) {
+      for (int x = 0; x < x_size; ++x, ++i) {
+        auto& cell = lines_[y][x];
+        cell->CachedComputeRequirement();
+        const Requirement requirement = cell->requirement();
+        const Cell updated = {
+            requirement.min_x,         requirement.min_y,
+            requirement.flex_grow_x,   requirement.flex_grow_y,
+            requirement.flex_shrink_x, requirement.flex_shrink_y,
+        };
+        if (cells_[i] != updated) {
+          cells_[i] = updated;
+          column_changed_[x] = true;
+          row_changed_[y] = true;
+        }
+
+        // Forward the focused/focused child state. The first one in column
+        // order is used.
+        if (requirement.focused.enabled &&
+            (x < focused_x || (x == focused_x && y < focused_y))) {
+          focused_x = x;
+          focused_y = y;
+          focused = requirement.focused;
+        }
       }
     }
 
+    UpdateAggregates();
+
     // Compute the size of each columns/row.
     std::vector<int> size_x(x_size, 0);
     std::vector<int> size_y(y_size, 0);
     for (int x = 0; x < x_size; ++x) {
-      for (int y = 0; y < y_size; ++y) {
-        size_x[x] = std::max(size_x[x], lines_[y][x]->requirement().min_x);
-        size_y[y] = std::max(size_y[y], lines_[y][x]->requirement().min_y);
-      }
+      size_x[x] = columns_[x].min_size;
+    }
+    for (int y = 0; y < y_size; ++y) {
+      size_y[y] = rows_[y].min_size;
     }
 
     requirement_.min_x = Integrate(size_x);
     requirement_.min_y = Integrate(size_y);
 
-    // Forward the focused/focused child state:
-    for (int x = 0; x < x_size; ++x) {
-      for (int y = 0; y < y_size; ++y) {
-        if (requirement_.focused.enabled ||
-            !lines_[y][x]->requirement().focused.enabled) {
-          continue;
-        }
-        requirement_.focused = lines_[y][x]->requirement().focused;
-        requirement_.focused.box.Shift(size_x[x], size_y[y]);
-      }
+    if (focused.enabled) {
+      requirement_.focused = focused;
+      requirement_.focused.box.Shift(size_x[focused_x], size_y[focused_y]);
     }
   }
 
   void SetBox(Box box) override {
     Node::SetBox(box);
 
-    box_helper::Element init;
-    init.min_size = 0;
-    init.flex_grow = 1024;    // NOLINT
-    init.flex_shrink = 1024;  // NOLINT
-    std::vector<box_helper::Element> elements_x(x_size, init);
-    std::vector<box_helper::Element> elements_y(y_size, init);
-
-    for (int y = 0; y < y_size; ++y) {
-      for (int x = 0; x < x_size; ++x) {
-        const auto& cell = lines_[y][x];
-        const auto& requirement = cell->requirement();
-        auto& e_x = elements_x[x];
-        auto& e_y = elements_y[y];
-        e_x.min_size = std::max(e_x.min_size, requirement.min_x);
-        e_y.min_size = std::max(e_y.min_size, requirement.min_y);
-        e_x.flex_grow = std::min(e_x.flex_grow, requirement.flex_grow_x);
-        e_y.flex_grow = std::min(e_y.flex_grow, requirement.flex_grow_y);
-        e_x.flex_shrink = std::min(e_x.flex_shrink, requirement.flex_shrink_x);
-        e_y.flex_shrink = std::min(e_y.flex_shrink, requirement.flex_shrink_y);
-      }
-    }
-
     const int target_size_x = box.x_max - box.x_min + 1;
     const int target_size_y = box.y_max - box.y_min + 1;
-    box_helper::Compute(&elements_x, target_size_x);
-    box_helper::Compute(&elements_y, target_size_y);
+    if (layout_changed_ || target_size_x != target_size_x_) {
+      box_helper::Compute(&columns_, target_size_x);
+    }
+    if (layout_changed_ || target_size_y != target_size_y_) {
+      box_helper::Compute(&rows_, target_size_y);
+    }
+    target_size_x_ = target_size_x;
+    target_size_y_ = target_size_y;
+    layout_changed_ = false;
 
     Box box_y = box;
     int y = box_y.y_min;
     for (int iy = 0; iy < y_size; ++iy) {
       box_y.y_min = y;
-      y += elements_y[iy].size;
+      y += rows_[iy].size;
       box_y.y_max = y - 1;
 
       Box box_x = box_y;
       int x = box_x.x_min;
       for (int ix = 0; ix < x_size; ++ix) {
         box_x.x_min = x;
-        x += elements_x[ix].size;
+        x += columns_[ix].size;
         box_x.x_max = x - 1;
-        lines_[iy][ix]->SetBox(box_x);
+        lines_[iy][ix]->CachedSetBox(box_x);
       }
     }
   }
 
-  void Render(Screen& screen) override {
+  void Select(Selection& selection) override {
+    // If this Node box_ doesn't intersect with the selection, then no
+    // selection.
+    if (Box::Intersection(selection.GetBox(), box_).IsEmpty()) {
+      return;
+    }
+
+    // Like a vbox of hbox: every row is selected from the start to the end of
+    // the selection, saturated to the row.
+    Selection selection_saturated = selection.SaturateVertical(box_);
+    Box row = box_;
+    row.y_max = box_.y_min - 1;
+    for (int y = 0; y < y_size; ++y) {
+      row.y_min = row.y_max + 1;
+      row.y_max = row.y_min + rows_[y].size - 1;
+      if (Box::Intersection(selection_saturated.GetBox(), row).IsEmpty()) {
+        continue;
+      }
+      Selection row_saturated = selection_saturated.SaturateHorizontal(row);
+      for (auto& cell : lines_[y]) {
+        cell->Select(row_saturated);
+      }
+    }
+  }
+
+  std::string GetSelectedContent(Selection& selection) override {
+    std::string content;
     for (auto& line : lines_) {
       for (auto& cell : line) {
-        cell->Render(screen);
+        content += cell->GetSelectedContent(selection);
       }
     }
+    return content;
+  }
+
+  void Render(Screen& screen) override {
+    if (RenderPool::Current() == nullptr) {
+      for (auto& line : lines_) {
+        for (auto& cell : line) {
+          cell->Render(screen);
+        }
+      }
+      return;
+    }
+
+    // Render all the cells together, so that they can be rendered in
+    // parallel.
+    Elements cells;
+    cells.reserve(cells_.size());
+    for (auto& line : lines_) {
+      cells.insert(cells.end(), line.begin(), line.end());
+    }
+    RenderPool::RenderChildren(screen, cells.data(),
+                               cells.data() + cells.size());
+  }
+
+  // The part of the requirement of a cell used by the layout.
+  struct Cell {
+    int min_x = 0;
+    int min_y = 0;
+    int flex_grow_x = 0;
+    int flex_grow_y = 0;
+    int flex_shrink_x = 0;
+    int flex_shrink_y = 0;
+
+    bool operator!=(const Cell& other) const {
+      return min_x != other.min_x || min_y != other.min_y ||
+             flex_grow_x != other.flex_grow_x ||
+             flex_grow_y != other.flex_grow_y ||
+             flex_shrink_x != other.flex_shrink_x ||
+             flex_shrink_y != other.flex_shrink_y;
+    }
+  };
+
+  // Recompute the aggregated requirement of the columns and rows whose cells
+  // changed, in a single pass in storage order.
+  void UpdateAggregates() {
+    box_helper::Element init;
+    init.min_size = 0;
+    init.flex_grow = 1024;    // NOLINT
+    init.flex_shrink = 1024;  // NOLINT
+
+    bool any_column_changed = false;
+    bool any_row_changed = false;
+    for (int x = 0; x < x_size; ++x) {
+      if (column_changed_[x]) {
+        columns_[x] = init;
+        any_column_changed = true;
+      }
+    }
+    for (int y = 0; y < y_size; ++y) {
+      if (row_changed_[y]) {
+        rows_[y] = init;
+        any_row_changed = true;
+      }
+    }
+    if (!any_column_changed && !any_row_changed) {
+      return;
+    }
+    layout_changed_ = true;
+
+    size_t i = 0;
+    for (int y = 0; y < y_size; ++y) {
+      const bool row_changed = row_changed_[y];
+      auto& row = rows_[y];
+      for (int x = 0; x < x_size; ++x, ++i) {
+        const Cell& cell = cells_[i];
+        if (row_changed) {
+          row.min_size = std::max(row.min_size, cell.min_y);
+          row.flex_grow = std::min(row.flex_grow, cell.flex_grow_y);
+          row.flex_shrink = std::min(row.flex_shrink, cell.flex_shrink_y);
+        }
+        if (column_changed_[x]) {
+          auto& column = columns_[x];
+          column.min_size = std::max(column.min_size, cell.min_x);
+          column.flex_grow = std::min(column.flex_grow, cell.flex_grow_x);
+          column.flex_shrink =
+              std::min(column.flex_shrink, cell.flex_shrink_x);
+        }
+      }
+    }
+
+    std::fill(column_changed_.begin(), column_changed_.end(), false);
+    std::fill(row_changed_.begin(), row_changed_.end(), false);
   }
 
   int x_size = 0;
   int y_size = 0;
   std::vector<Elements> lines_;
+
+  // Cached requirement of the cells, in storage order, and their aggregation
+  // per column and per row.
+  std::vector<Cell> cells_;
+  std::vector<box_helper::Element> columns_;
+  std::vector<box_helper::Element> rows_;
+  std::vector<bool> column_changed_;
+  std::vector<bool> row_changed_;
+  bool layout_changed_ = true;
+  int target_size_x_ = -1;
+  int target_size_y_ = -1;
 };
 }  // namespace
    //
@@ -171,7 +318,7 @@ class GridBox : public Node {
 /// ╰──────────╯╰──────╯╰──────────╯
 /// ```
 Element gridbox(std::vector<Elements> lines) {
-  return std::make_shared<GridBox>(std::move(lines));
+  return MakeNode<GridBox>(std::move(lines));
 }
 
 }  // namespace ftxui
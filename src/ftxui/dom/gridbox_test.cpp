@@ -4,12 +4,14 @@
 #include <gtest/gtest.h>
 #include <algorithm>  // for remove
 #include <cstddef>    // for size_t
+#include <memory>     // for make_shared
 #include <string>     // for allocator, basic_string, string
 #include <vector>     // for vector
 
 #include "ftxui/dom/elements.hpp"  // for text, operator|, Element, flex, Elements, flex_grow, flex_shrink, vtext, gridbox, vbox, select, operator|=, border, frame
-#include "ftxui/dom/node.hpp"      // for Render
-#include "ftxui/screen/screen.hpp"  // for Screen
+#include "ftxui/dom/node.hpp"      // for Node, Render
+#include "ftxui/dom/selection.hpp"  // for Selection
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
 
 // NOLINTBEGIN
 namespace ftxui {
@@ -24,6 +26,28 @@ std::string rotate(std::string str) {
 Element cell(const char* t) {
   return text(t) | border;
 }
+
+// A square of |*size| cells, read at every layout.
+class Resizable : public Node {
+ public:
+  explicit Resizable(int* size) : size_(size) {}
+
+  void ComputeRequirement() override {
+    requirement_.min_x = *size_;
+    requirement_.min_y = *size_;
+  }
+
+  void Render(Screen& screen) override {
+    for (int y = box_.y_min; y <= box_.y_max; ++y) {
+      for (int x = box_.x_min; x <= box_.x_max; ++x) {
+        screen.PixelAt(x, y).character = "x";
+      }
+    }
+  }
+
+ private:
+  int* size_;
+};
 }  // namespace
 
 TEST(GridboxTest, UnfilledRectangular) {
@@ -617,5 +641,39 @@ TEST(GridboxTest, Focus) {
             "╰──╯");
 }
 
+TEST(GridboxTest, CellResizedInBetweenFrames) {
+  int size = 1;
+  auto make = [&] {
+    return gridbox({
+        {std::make_shared<Resizable>(&size), cell("a")},
+        {cell("b"), cell("c") | flex},
+    });
+  };
+  auto reused = make();
+  for (int new_size : {1, 3, 3, 2, 5, 1}) {
+    size = new_size;
+    Screen screen_reused(12, 10);
+    Render(screen_reused, reused);
+    Screen screen_fresh(12, 10);
+    Render(screen_fresh, make());
+    EXPECT_EQ(screen_reused.ToString(), screen_fresh.ToString());
+  }
+}
+
+TEST(GridboxTest, Selection) {
+  auto root = gridbox({
+      {text("abc"), text("def")},
+      {text("ghi"), text("jkl")},
+  });
+
+  Screen screen(6, 2);
+  Selection selection(1, 0, 3, 1);
+  Render(screen, root.get(), selection);
+  EXPECT_EQ(selection.GetParts(), "bcdef\nghij");
+  EXPECT_EQ(screen.ToString(),
+            "a\x1B[7mbcdef\x1B[27m\r\n"
+            "\x1B[7mghij\x1B[27mkl");
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -1,18 +1,21 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max
+#include <algorithm>  // for max, upper_bound
 #include <cstddef>    // for size_t
-#include <memory>  // for __shared_ptr_access, shared_ptr, make_shared, allocator_traits<>::value_type
+#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type
 #include <utility>  // for move
 #include <vector>   // for vector, __alloc_traits<>::value_type
 
+#include "ftxui/dom/arena.hpp"        // for MakeNode
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, hbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
+#include "ftxui/dom/render_pool.hpp"  // for RenderPool
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/dom/selection.hpp"    // for Selection
 #include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
 namespace ftxui {
 
 namespace {
@@ -25,18 +28,18 @@ class HBox : public Node {
     requirement_ = Requirement{};
 
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      child->CachedComputeRequirement();
+      const Requirement requirement = child->requirement();
 
       // Propagate the focused requirement.
-      if (requirement_.focused.Prefer(child->requirement().focused)) {
-        requirement_.focused = child->requirement().focused;
+      if (requirement_.focused.Prefer(requirement.focused)) {
+        requirement_.focused = requirement.focused;
         requirement_.focused.box.Shift(requirement_.min_x, 0);
       }
 
       // Extend the min_x and min_y to contain all the children
-      requirement_.min_x += child->requirement().min_x;
-      requirement_.min_y =
-          std::max(requirement_.min_y, child->requirement().min_y);
+      requirement_.min_x += requirement.min_x;
+      requirement_.min_y = std::max(requirement_.min_y, requirement.min_y);
     }
   }
 
@@ -54,13 +57,38 @@ class HBox : public Node {
     const int target_size = box.x_max - box.x_min + 1;
     box_helper::Compute(&elements, target_size);
 
+    // Every child is given a box, even the ones outside of the screen, because
+    // reflect() and focus rely on them.
+    x_.resize(children_.size() + 1);
     int x = box.x_min;
     for (size_t i = 0; i < children_.size(); ++i) {
+      x_[i] = x;
       box.x_min = x;
       box.x_max = x + elements[i].size - 1;
-      children_[i]->SetBox(box);
+      children_[i]->CachedSetBox(box);
       x = box.x_max + 1;
     }
+    x_[children_.size()] = x;
+  }
+
+  void Render(Screen& screen) override {
+    if (x_.size() != children_.size() + 1) {
+      Node::Render(screen);
+      return;
+    }
+
+    // The children are laid out in order. Render only the ones intersecting
+    // the stencil. In a frame, this is proportional to the visible part only.
+    const int stencil_min = screen.stencil.x_min;
+    const int stencil_max = screen.stencil.x_max;
+    const auto first = std::upper_bound(x_.begin() + 1, x_.end(), stencil_min);
+    const size_t begin = first - (x_.begin() + 1);
+    size_t end = begin;
+    while (end < children_.size() && x_[end] <= stencil_max) {
+      ++end;
+    }
+    RenderPool::RenderChildren(screen, children_.data() + begin,
+                               children_.data() + end);
   }
 
   void Select(Selection& selection) override {
@@ -75,6 +103,9 @@ class HBox : public Node {
       child->Select(selection_saturated);
     }
   }
+
+  // The x coordinate of every child, followed by the end of the last one.
+  std::vector<int> x_;
 };
 
 }  // namespace
@@ -92,7 +123,7 @@ class HBox : public Node {
 /// });
 /// ```
 Element hbox(Elements children) {
-  return std::make_shared<HBox>(std::move(children));
+  return MakeNode<HBox>(std::move(children));
 }
 
 }  // namespace ftxui
@@ -2,19 +2,21 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <algorithm>                      // for max, min, sort, copy
-#include <cmath>                          // for fmod, cos, sin
+#include <cmath>  // for fmod, cos, sin, abs, isfinite, lround
 #include <cstddef>                        // for size_t
 #include <ftxui/dom/linear_gradient.hpp>  // for LinearGradient::Stop, LinearGradient
-#include <memory>    // for allocator_traits<>::value_type, make_shared
+#include <memory>    // for allocator_traits<>::value_type
 #include <optional>  // for optional, operator!=, operator<
 #include <utility>   // for move
 #include <vector>    // for vector
 
+#include "ftxui/dom/arena.hpp"     // for MakeNode
 #include "ftxui/dom/elements.hpp"  // for Element, Decorator, bgcolor, color
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
 #include "ftxui/screen/box.hpp"          // for Box
 #include "ftxui/screen/color.hpp"   // for Color, Color::Default, Color::Blue
 #include "ftxui/screen/screen.hpp"  // for Pixel, Screen
+#include "ftxui/screen/terminal.hpp"  // for ColorSupport, Color
 
 namespace ftxui {
 namespace {
@@ -148,23 +150,55 @@ class LinearGradientColor : public NodeDecorator {
 
     // Renormalize the projection to [0, 1] using the extent and projective
     // geometry.
-    const float dX = dx / (max - min);
-    const float dY = dy / (max - min);
-    const float dZ = -min / (max - min);
-
-    // Project every pixel to get the color.
-    if (background_color_) {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
-          const float t = float(x) * dX + float(y) * dY + dZ;
-          screen.PixelAt(x, y).background_color = Interpolate(gradient_, t);
-        }
-      }
+    float dX = dx / (max - min);
+    float dY = dy / (max - min);
+    float dZ = -min / (max - min);
+
+    // Sample the gradient twice per step of the projection in between two
+    // adjacent cells, once per render. Every cell takes the color of the
+    // nearest sample. A box without extent takes the color at the end of the
+    // gradient.
+    const float step = std::max(std::abs(dX), std::abs(dY));
+    int intervals = 0;
+    if (std::isfinite(step) && std::isfinite(dZ) && step > 0.F) {
+      intervals = 2 * std::max(1, int(std::lround(1.F / step)));
     } else {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
-          const float t = float(x) * dX + float(y) * dY + dZ;
-          screen.PixelAt(x, y).foreground_color = Interpolate(gradient_, t);
+      dX = 0.F;
+      dY = 0.F;
+      dZ = 1.F;
+    }
+    // The interpolated colors are quantized for the current color support.
+    const Terminal::Color color_support = Terminal::ColorSupport();
+    if (ramp_.size() != size_t(intervals) + 1 ||
+        ramp_color_support_ != color_support) {
+      ramp_color_support_ = color_support;
+      ramp_.resize(size_t(intervals) + 1);
+      for (int i = 0; i <= intervals; ++i) {
+        const float t = intervals ? float(i) / float(intervals) : 1.F;
+        ramp_[i] = Interpolate(gradient_, t);
+      }
+    }
+
+    const Box area = Box::Intersection(box_, screen.stencil);
+    const float scale = float(intervals);
+    samples_.resize(size_t(std::max(0, area.x_max - area.x_min + 1)));
+    for (int y = area.y_min; y <= area.y_max; ++y) {
+      // Compute the samples of the row first, in a loop the compiler can
+      // vectorize.
+      for (int x = area.x_min; x <= area.x_max; ++x) {
+        const float t = float(x) * dX + float(y) * dY + dZ;
+        const float sample = std::min(std::max(t * scale + 0.5F, 0.F), scale);
+        samples_[x - area.x_min] = int(sample);
+      }
+      if (background_color_) {
+        for (int x = area.x_min; x <= area.x_max; ++x) {
+          screen.PixelAt(x, y).background_color =
+              ramp_[samples_[x - area.x_min]];
+        }
+      } else {
+        for (int x = area.x_min; x <= area.x_max; ++x) {
+          screen.PixelAt(x, y).foreground_color =
+              ramp_[samples_[x - area.x_min]];
         }
       }
     }
@@ -174,6 +208,12 @@ class LinearGradientColor : public NodeDecorator {
 
   LinearGradientNormalized gradient_;
   bool background_color_;
+
+  // The gradient sampled at regular intervals. Kept in between renders, as
+  // it only depends on the number of samples and the color support.
+  std::vector<Color> ramp_;
+  Terminal::Color ramp_color_support_ = Terminal::Color::TrueColor;
+  std::vector<int> samples_;  // The sample of every cell of a row.
 };
 
 }  // namespace
@@ -243,8 +283,8 @@ LinearGradient& LinearGradient::Stop(Color c) {
 /// color(LinearGradient{0, {Color::Red, Color::Blue}}, text("Hello"))
 /// ```
 Element color(const LinearGradient& gradient, Element child) {
-  return std::make_shared<LinearGradientColor>(std::move(child), gradient,
-                                               /*background_color*/ false);
+  return MakeNode<LinearGradientColor>(std::move(child), gradient,
+                                       /*background_color*/ false);
 }
 
 /// @brief Set the background color of an element with linear-gradient effect.
@@ -259,8 +299,8 @@ Element color(const LinearGradient& gradient, Element child) {
 /// bgcolor(LinearGradient{0, {Color::Red, Color::Blue}}, text("Hello"))
 /// ```
 Element bgcolor(const LinearGradient& gradient, Element child) {
-  return std::make_shared<LinearGradientColor>(std::move(child), gradient,
-                                               /*background_color*/ true);
+  return MakeNode<LinearGradientColor>(std::move(child), gradient,
+                                       /*background_color*/ true);
 }
 
 /// @brief Decorate using a linear-gradient effect on the foreground color.
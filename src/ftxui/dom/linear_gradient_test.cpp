@@ -4,10 +4,16 @@
 #include <gtest/gtest.h>  // for Test, EXPECT_EQ, Message, TestPartResult, TestInfo (ptr only), TEST
 #include <ftxui/dom/linear_gradient.hpp>  // for LinearGradient::Stop, LinearGradient
 
-#include "ftxui/dom/elements.hpp"  // for operator|, text, bgcolor, color, Element
+#include <algorithm>  // for max, min
+#include <cmath>      // for cos, sin, abs
+#include <sstream>    // for istringstream
+#include <string>     // for string, getline
+
+#include "ftxui/dom/elements.hpp"  // for operator|, text, bgcolor, color, Element, filler
 #include "ftxui/dom/node.hpp"      // for Render
 #include "ftxui/screen/color.hpp"   // for Color, Color::RedLight, Color::Red
 #include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+#include "ftxui/screen/terminal.hpp"  // for SetColorSupport, TrueColor
 
 // NOLINTBEGIN
 namespace ftxui {
@@ -86,5 +92,91 @@ TEST(ColorTest, GradientBackground) {
   EXPECT_EQ(screen.PixelAt(4, 0).background_color, gradient_end);
 }
 
+// A gradient rendered again uses the colors for the current color support.
+TEST(ColorTest, GradientColorSupportChange) {
+  auto make = [] {
+    return text("text") | color(LinearGradient(Color::RGB(255, 0, 0),
+                                               Color::RGB(0, 0, 255)));
+  };
+  auto print = [](Element element) {
+    Screen screen(5, 1);
+    Render(screen, element);
+    std::string out;
+    for (int x = 0; x < 5; ++x) {
+      out += screen.PixelAt(x, 0).foreground_color.Print(false) + " ";
+    }
+    return out;
+  };
+
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  auto element = make();
+  const std::string true_color = print(element);
+  Terminal::SetColorSupport(Terminal::Color::Palette16);
+  const std::string palette = print(element);
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+
+  EXPECT_NE(palette, true_color);
+  Terminal::SetColorSupport(Terminal::Color::Palette16);
+  EXPECT_EQ(palette, print(make()));
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  EXPECT_EQ(true_color, print(element));
+}
+
+namespace {
+// The red, green and blue channels of a TrueColor.
+std::vector<int> Channels(const Color& color) {
+  std::istringstream input(color.Print(false));
+  std::vector<int> out;
+  std::string value;
+  while (std::getline(input, value, ';')) {
+    out.push_back(std::stoi(value));
+  }
+  return {out.begin() + 2, out.end()};  // Skip "38;2".
+}
+}  // namespace
+
+// The colors are sampled from a ramp, twice per cell along the gradient,
+// instead of computed for every cell. Check every cell takes the exact color
+// of a point within a quarter of a cell.
+TEST(ColorTest, GradientTolerance) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  const Color begin = Color::RGB(255, 40, 0);
+  const Color end = Color::RGB(0, 90, 255);
+  for (float angle : {0.F, 17.F, 30.F, 45.F, 90.F, 135.F, 200.F, 300.F}) {
+    Screen screen(53, 17);
+    Render(screen, filler() | bgcolor(LinearGradient(angle, begin, end)));
+
+    const float dx = std::cos(angle * 0.01745329251F);
+    const float dy = std::sin(angle * 0.01745329251F);
+    const float p1 = 0.F;
+    const float p2 = 16.F * dy;
+    const float p3 = 52.F * dx;
+    const float p4 = 52.F * dx + 16.F * dy;
+    const float min = std::min({p1, p2, p3, p4});
+    const float max = std::max({p1, p2, p3, p4});
+    const float delta = std::max(std::abs(dx), std::abs(dy)) / (max - min) / 4;
+    auto exact = [&](float t) {
+      t = std::min(std::max(t, 0.F), 1.F);
+      return Channels(Color::Interpolate(t, begin, end));
+    };
+    for (int y = 0; y < 17; ++y) {
+      for (int x = 0; x < 53; ++x) {
+        const float t = (float(x) * dx + float(y) * dy - min) / (max - min);
+        const std::vector<int> before = exact(t - delta);
+        const std::vector<int> after = exact(t + delta);
+        const std::vector<int> actual =
+            Channels(screen.PixelAt(x, y).background_color);
+        ASSERT_EQ(actual.size(), 3u);
+        for (int i = 0; i < 3; ++i) {
+          EXPECT_GE(actual[i], std::min(before[i], after[i]) - 1)
+              << "angle=" << angle << " x=" << x << " y=" << y;
+          EXPECT_LE(actual[i], std::max(before[i], after[i]) + 1)
+              << "angle=" << angle << " x=" << x << " y=" << y;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace ftxui
 // NOLINTEND
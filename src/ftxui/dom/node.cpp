@@ -22,7 +22,7 @@ void Node::ComputeRequirement() {
     return;
   }
   for (auto& child : children_) {
-    child->ComputeRequirement();
+    child->CachedComputeRequirement();
   }
 
   // By default, the requirement is the one of the first child.
@@ -40,6 +40,7 @@ void Node::ComputeRequirement() {
 /// @brief Assign a position and a dimension to an element for drawing.
 void Node::SetBox(Box box) {
   box_ = box;
+  layout_visited_ = true;
 }
 
 /// @brief Compute the selection of an element.
@@ -64,9 +65,46 @@ void Node::Render(Screen& screen) {
 
 void Node::Check(Status* status) {
   for (auto& child : children_) {
-    child->Check(status);
+    child->CachedCheck(status);
   }
   status->need_iteration |= (status->iteration == 0);
+  layout_dirty_ |= (status->iteration == 0);
+}
+
+/// @brief Same as ComputeRequirement(), but skipped when the subtree didn't
+/// request another iteration of the layout.
+void Node::CachedComputeRequirement() {
+  if (!layout_dirty_) {
+    return;
+  }
+  ComputeRequirement();
+  layout_visited_ = true;
+}
+
+/// @brief Same as SetBox(), but skipped when the subtree didn't request
+/// another iteration of the layout, and is given the same box as before.
+void Node::CachedSetBox(Box box) {
+  if (!layout_dirty_ && box == layout_box_) {
+    return;
+  }
+  SetBox(box);
+  layout_box_ = box;
+  layout_visited_ = true;
+}
+
+/// @brief Same as Check(), but records whether this subtree requested another
+/// iteration. Subtrees whose layout wasn't updated since the previous Check()
+/// can't request one, and aren't visited.
+void Node::CachedCheck(Status* status) {
+  if (status->iteration != 0 && !layout_dirty_ && !layout_visited_) {
+    return;
+  }
+  const bool need_iteration = status->need_iteration;
+  status->need_iteration = false;
+  Check(status);
+  layout_dirty_ = status->need_iteration || status->iteration == 0;
+  layout_visited_ = false;
+  status->need_iteration |= need_iteration;
 }
 
 std::string Node::GetSelectedContent(Selection& selection) {
@@ -101,19 +139,20 @@ void Render(Screen& screen, Node* node, Selection& selection) {
   box.y_max = screen.dimy() - 1;
 
   Node::Status status;
-  node->Check(&status);
+  status.same_box = (node->box_ == box);
+  node->CachedCheck(&status);
   const int max_iterations = 20;
   while (status.need_iteration && status.iteration < max_iterations) {
     // Step 1: Find what dimension this elements wants to be.
-    node->ComputeRequirement();
+    node->CachedComputeRequirement();
 
     // Step 2: Assign a dimension to the element.
-    node->SetBox(box);
+    node->CachedSetBox(box);
 
     // Check if the element needs another iteration of the layout algorithm.
     status.need_iteration = false;
     status.iteration++;
-    node->Check(&status);
+    node->CachedCheck(&status);
   }
 
   // Step 3: Selection
@@ -175,19 +214,19 @@ std::string GetNodeSelectedContent(Screen& screen,
   box.y_max = screen.dimy() - 1;
 
   Node::Status status;
-  node->Check(&status);
+  node->CachedCheck(&status);
   const int max_iterations = 20;
   while (status.need_iteration && status.iteration < max_iterations) {
     // Step 1: Find what dimension this elements wants to be.
-    node->ComputeRequirement();
+    node->CachedComputeRequirement();
 
     // Step 2: Assign a dimension to the element.
-    node->SetBox(box);
+    node->CachedSetBox(box);
 
     // Check if the element needs another iteration of the layout algorithm.
     status.need_iteration = false;
     status.iteration++;
-    node->Check(&status);
+    node->CachedCheck(&status);
   }
 
   // Step 3: Selection
@@ -0,0 +1,283 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/render_pool.hpp"
+
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint8_t
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <memory>              // for unique_ptr, make_unique
+#include <mutex>               // for mutex, unique_lock, lock_guard
+#include <string>              // for string
+#include <thread>              // for thread
+#include <utility>             // for move
+#include <vector>              // for vector
+
+#include "ftxui/dom/node.hpp"       // for Node, Element
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+
+namespace ftxui {
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local RenderPool* g_current_pool = nullptr;
+
+// Children smaller than this number of visible cells are not worth the cost
+// of a task, and are rendered by the calling thread.
+constexpr int kMinTaskArea = 1024;
+
+int Area(const Box& box) {
+  return (box.x_max - box.x_min + 1) * (box.y_max - box.y_min + 1);
+}
+
+// A view drawing into a part of another screen. It has its own stencil and
+// hyperlinks, so that the parts can be rendered concurrently.
+class PartialScreen : public Screen {
+ public:
+  PartialScreen(Screen& parent,
+                Box area,
+                const std::vector<std::string>& hyperlinks)
+      : Screen(parent, area) {
+    hyperlinks_ = hyperlinks;
+    SetSelectionStyle(parent.GetSelectionStyle());
+  }
+
+  // Register the hyperlinks added while rendering into |parent|, and update
+  // the ids of the pixels. Must be called in the order of
+  // the sequential rendering, for the ids to be the same.
+  void MergeHyperlinks(Screen& parent, size_t previous) {
+    if (hyperlinks_.size() == previous) {
+      return;
+    }
+    std::vector<uint8_t> ids(hyperlinks_.size());
+    for (size_t id = 0; id < ids.size(); ++id) {
+      ids[id] = id < previous ? uint8_t(id)
+                              : parent.RegisterHyperlink(hyperlinks_[id]);
+    }
+    for (int y = stencil.y_min; y <= stencil.y_max; ++y) {
+      for (int x = stencil.x_min; x <= stencil.x_max; ++x) {
+        uint8_t& hyperlink = PixelAt(x, y).hyperlink;
+        hyperlink = ids[hyperlink];
+      }
+    }
+  }
+};
+
+}  // namespace
+
+// A work-stealing pool. Every thread owns a queue, pushing and popping tasks
+// at its back. Idle threads steal tasks from the front of the other queues.
+struct RenderPool::Internal {
+  using Task = std::function<void()>;
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  Internal(RenderPool* owner, int threads)
+      : queues(size_t(threads) + 1), pool(owner) {
+    for (int i = 0; i < threads; ++i) {
+      workers.emplace_back([this, i] { Work(size_t(i)); });
+    }
+  }
+
+  ~Internal() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      quit = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // The queue of the current thread. The threads outside of the pool share
+  // the last one.
+  size_t OwnQueue() const {
+    return current_internal == this ? current_queue : queues.size() - 1;
+  }
+
+  void Post(Task task) {
+    {
+      Queue& queue = queues[OwnQueue()];
+      const std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      ++pending;
+    }
+    // Wake a worker, or a thread waiting for its own tasks to complete.
+    wake.notify_all();
+  }
+
+  // Run a task from the own queue, or stolen from another one.
+  bool RunOne() {
+    const size_t own = OwnQueue();
+    Task task;
+    for (size_t i = 0; i < queues.size() && !task; ++i) {
+      Queue& queue = queues[(own + i) % queues.size()];
+      const std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    if (!task) {
+      return false;
+    }
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      --pending;
+    }
+    task();
+
+    // Wake the threads waiting for this task to complete. Locking the mutex
+    // orders the completion with their check of the predicate.
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+    }
+    wake.notify_all();
+    return true;
+  }
+
+  // Help running the tasks until |remaining| reaches zero. Block while every
+  // remaining task is being run by other threads.
+  void Wait(const std::atomic<int>& remaining) {
+    while (remaining.load(std::memory_order_acquire) != 0) {
+      if (RunOne()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&] {
+        return remaining.load(std::memory_order_acquire) == 0 || pending > 0;
+      });
+    }
+  }
+
+  void Work(size_t index) {
+    current_internal = this;
+    current_queue = index;
+    const Scope scope(pool);
+    while (true) {
+      if (RunOne()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&] { return quit || pending > 0; });
+      if (quit) {
+        return;
+      }
+    }
+  }
+
+  std::vector<Queue> queues;
+  std::vector<std::thread> workers;
+  RenderPool* pool;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  int pending = 0;  // The number of queued tasks. Guarded by |mutex|.
+  bool quit = false;
+
+  static thread_local Internal* current_internal;
+  static thread_local size_t current_queue;
+};
+
+thread_local RenderPool::Internal* RenderPool::Internal::current_internal =
+    nullptr;
+thread_local size_t RenderPool::Internal::current_queue = 0;
+
+RenderPool::RenderPool(int threads)
+    : internal_(std::make_unique<Internal>(this, threads)) {}
+
+RenderPool::~RenderPool() = default;
+
+// static
+RenderPool* RenderPool::Current() {
+  return g_current_pool;
+}
+
+RenderPool::Scope::Scope(RenderPool* pool) : previous_(g_current_pool) {
+  g_current_pool = pool;
+}
+
+RenderPool::Scope::~Scope() {
+  g_current_pool = previous_;
+}
+
+// static
+void RenderPool::RenderChildren(Screen& screen,
+                                const Element* begin,
+                                const Element* end) {
+  RenderPool* pool = Current();
+  const size_t count = end - begin;
+  std::vector<Box> areas;
+  int tasks = 0;
+  if (pool != nullptr && count >= 2) {
+    // Estimate the cost of each child by its visible area.
+    areas.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      areas[i] = Box::Intersection(begin[i]->box_, screen.stencil);
+      if (areas[i].IsEmpty() || Area(areas[i]) < kMinTaskArea) {
+        areas[i] = Box{0, -1, 0, -1};
+      } else {
+        ++tasks;
+      }
+    }
+  }
+
+  if (tasks < 2) {
+    for (const Element* child = begin; child != end; ++child) {
+      (*child)->Render(screen);
+    }
+    return;
+  }
+
+  std::vector<std::string> hyperlinks = {""};
+  while (hyperlinks.size() < 256) {
+    const std::string& link = screen.Hyperlink(uint8_t(hyperlinks.size()));
+    if (link.empty()) {
+      break;
+    }
+    hyperlinks.push_back(link);
+  }
+
+  std::vector<std::unique_ptr<PartialScreen>> parts(count);
+  std::atomic<int> remaining(tasks);
+  for (size_t i = 0; i < count; ++i) {
+    if (areas[i].IsEmpty()) {
+      continue;
+    }
+    pool->internal_->Post([&, i] {
+      auto part = std::make_unique<PartialScreen>(screen, areas[i], hyperlinks);
+      begin[i]->Render(*part);
+      parts[i] = std::move(part);
+      remaining.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  pool->internal_->Wait(remaining);
+
+  // Render the small children, and merge the hyperlinks, in order.
+  for (size_t i = 0; i < count; ++i) {
+    if (parts[i]) {
+      parts[i]->MergeHyperlinks(screen, hyperlinks.size());
+    } else {
+      begin[i]->Render(screen);
+    }
+  }
+}
+
+}  // namespace ftxui
@@ -0,0 +1,16 @@
+/// @module ftxui.dom.render_pool
+/// @brief Module file for the RenderPool class of the Dom module
+
+module;
+
+#include <ftxui/dom/render_pool.hpp>
+
+export module ftxui.dom.render_pool;
+
+/**
+ * @namespace ftxui
+ * @brief The FTXUI ftxui:: namespace
+ */
+export namespace ftxui {
+    using ftxui::RenderPool;
+}
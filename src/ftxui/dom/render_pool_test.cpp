@@ -0,0 +1,86 @@
+// Copyright 2025 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <string>  // for allocator, string, to_string
+#include <vector>  // for vector
+
+#include "ftxui/dom/canvas.hpp"  // for Canvas
+#include "ftxui/dom/elements.hpp"  // for operator|, text, border, hbox, vbox, gridbox, canvas, frame, hyperlink, Element
+#include "ftxui/dom/node.hpp"         // for Render
+#include "ftxui/dom/render_pool.hpp"  // for RenderPool, RenderPool::Scope
+#include "ftxui/screen/color.hpp"     // for Color
+#include "ftxui/screen/screen.hpp"    // for Screen
+#include "gtest/gtest.h"  // for Test, EXPECT_EQ, Message, TEST, TestPartResult
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+Element Tile(int i) {
+  Elements lines;
+  for (int y = 0; y < 40; ++y) {
+    lines.push_back(text("line " + std::to_string(y) + " of tile " +
+                         std::to_string(i)));
+  }
+  return vbox({
+             text("Tile " + std::to_string(i)) |
+                 hyperlink("https://" + std::to_string(i % 3) + ".com"),
+             hbox({
+                 canvas([i](Canvas& c) {
+                   c.DrawPointLine(0, 0, c.width(), c.height(), Color::Red);
+                   c.DrawText(0, 8 * (i % 3), "canvas");
+                 }) | flex,
+                 vbox(std::move(lines)) | focusPositionRelative(0.f, 0.5f) |
+                     frame | flex,
+             }) | flex,
+         }) |
+         border | flex;
+}
+
+Element Document() {
+  return vbox({
+      text("Monitoring") | hyperlink("https://title.com"),
+      gridbox({
+          {Tile(0), Tile(1), Tile(2)},
+          {Tile(3), Tile(4), Tile(5)},
+      }) | flex,
+      hbox({Tile(6), Tile(7)}) | flex,
+  });
+}
+
+std::string Draw(int threads) {
+  Screen screen(180, 90);
+  if (threads < 0) {
+    Render(screen, Document());
+  } else {
+    RenderPool pool(threads);
+    RenderPool::Scope scope(&pool);
+    EXPECT_EQ(RenderPool::Current(), &pool);
+    Render(screen, Document());
+  }
+  return screen.ToString();
+}
+}  // namespace
+
+TEST(RenderPoolTest, SameAsSequential) {
+  const std::string expected = Draw(-1);
+  EXPECT_EQ(Draw(0), expected);
+  EXPECT_EQ(Draw(1), expected);
+  EXPECT_EQ(Draw(3), expected);
+  EXPECT_EQ(RenderPool::Current(), nullptr);
+}
+
+TEST(RenderPoolTest, ReusedInBetweenFrames) {
+  RenderPool pool(2);
+  RenderPool::Scope scope(&pool);
+  auto document = Document();
+  Screen screen(180, 90);
+  for (int i = 0; i < 10; ++i) {
+    screen.Clear();
+    Render(screen, document);
+  }
+  EXPECT_EQ(screen.ToString(), Draw(-1));
+}
+
+}  // namespace ftxui
+// NOLINTEND
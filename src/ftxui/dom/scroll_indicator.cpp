@@ -2,10 +2,11 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <algorithm>  // for max
-#include <memory>     // for make_shared, __shared_ptr_access
+#include <memory>     // for __shared_ptr_access
 #include <string>     // for string
 #include <utility>    // for move
 
+#include "ftxui/dom/arena.hpp"     // for MakeNode
 #include "ftxui/dom/elements.hpp"  // for Element, vscroll_indicator, hscroll_indicator
 #include "ftxui/dom/node.hpp"            // for Node, Elements
 #include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
@@ -31,7 +32,7 @@ Element vscroll_indicator(Element child) {
     void SetBox(Box box) override {
       box_ = box;
       box.x_max--;
-      children_[0]->SetBox(box);
+      children_[0]->CachedSetBox(box);
     }
 
     void Render(Screen& screen) final {
@@ -67,7 +68,7 @@ Element vscroll_indicator(Element child) {
       }
     }
   };
-  return std::make_shared<Impl>(std::move(child));
+  return MakeNode<Impl>(std::move(child));
 }
 
 /// @brief Display a horizontal scrollbar at the bottom.
@@ -86,7 +87,7 @@ Element hscroll_indicator(Element child) {
     void SetBox(Box box) override {
       box_ = box;
       box.y_max--;
-      children_[0]->SetBox(box);
+      children_[0]->CachedSetBox(box);
     }
 
     void Render(Screen& screen) final {
@@ -123,7 +124,7 @@ Element hscroll_indicator(Element child) {
       }
     }
   };
-  return std::make_shared<Impl>(std::move(child));
+  return MakeNode<Impl>(std::move(child));
 }
 
 }  // namespace ftxui
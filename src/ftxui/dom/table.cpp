@@ -1,15 +1,25 @@
 // Copyright 2021 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include "ftxui/dom/arena.hpp"  // for MakeNode
 #include "ftxui/dom/table.hpp"
 
-#include <algorithm>         // for max
+#include <algorithm>         // for max, min, sort
+#include <cstdint>           // for int64_t
+#include <functional>        // for function
 #include <initializer_list>  // for initializer_list
-#include <memory>   // for allocator, shared_ptr, allocator_traits<>::value_type
-#include <utility>  // for move, swap
+#include <memory>   // for allocator, shared_ptr, allocator_traits<>::value_type, make_shared
+#include <string>   // for string
+#include <utility>  // for move, swap, pair
 #include <vector>   // for vector
 
+#include "ftxui/dom/box_helper.hpp"  // for Element, Compute
 #include "ftxui/dom/elements.hpp"  // for Element, operator|, text, separatorCharacter, Elements, BorderStyle, Decorator, emptyElement, size, gridbox, EQUAL, flex, flex_shrink, HEIGHT, WIDTH
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/dom/selection.hpp"    // for Selection
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
 
 namespace ftxui {
 namespace {
@@ -41,6 +51,207 @@ void Order(int& a, int& b) {
   }
 }
 
+// Make the element of the grid at (x, y) fill its row and its column.
+Element GridElement(Element element, int x, int y) {
+  // Line
+  if ((x + y) % 2 == 1) {
+    return std::move(element) | flex;
+  }
+
+  // Cells
+  if ((x % 2) == 1 && (y % 2) == 1) {
+    return std::move(element) | flex_shrink;
+  }
+
+  // Corners
+  return std::move(element) | size(WIDTH, EQUAL, 0) | size(HEIGHT, EQUAL, 0);
+}
+
+// The number of even integers in [min, max].
+int EvenCount(int min, int max) {
+  return max / 2 - (min + 1) / 2 + 1;
+}
+
+// A table whose rows are materialized on demand, only for the visible part of
+// the screen. Every row is one cell tall. The separator rows are either one
+// cell tall or empty.
+class VirtualTable : public Node {
+ public:
+  using Materialize = std::function<std::vector<Elements>(int, int)>;
+  VirtualTable(Materialize materialize,
+               std::vector<int> widths,
+               std::vector<int> flex_grow,
+               std::vector<int> flex_shrink,
+               int dim_y,
+               std::vector<std::pair<int, int>> tall_separators)
+      : materialize_(std::move(materialize)),
+        widths_(std::move(widths)),
+        flex_grow_(std::move(flex_grow)),
+        dim_y_(dim_y),
+        tall_separators_(std::move(tall_separators)) {
+    for (const int flex : flex_grow_) {
+      flex_grow_x_ = std::max(flex_grow_x_, flex);
+    }
+    for (const int flex : flex_shrink) {
+      flex_shrink_x_ = std::max(flex_shrink_x_, flex);
+    }
+  }
+
+  void ComputeRequirement() override {
+    requirement_ = Requirement{};
+    for (const int width : widths_) {
+      requirement_.min_x += width;
+    }
+    requirement_.min_y = Top(dim_y_);
+    requirement_.flex_grow_x = flex_grow_x_;
+    requirement_.flex_shrink_x = flex_shrink_x_;
+    selected_ = nullptr;
+  }
+
+  // Distribute the width among the columns, like the gridbox of a regular
+  // table: the cells can shrink, and grow when their column is flexible.
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    std::vector<box_helper::Element> columns(widths_.size());
+    for (size_t x = 0; x < columns.size(); ++x) {
+      columns[x].min_size = widths_[x];
+      if (x % 2 == 1) {
+        columns[x].flex_grow = flex_grow_[x];
+        columns[x].flex_shrink = 1;
+      }
+    }
+    box_helper::Compute(&columns, box.x_max - box.x_min + 1);
+    sizes_.resize(columns.size());
+    for (size_t x = 0; x < columns.size(); ++x) {
+      sizes_[x] = columns[x].size;
+    }
+  }
+
+  void Select(Selection& selection) override {
+    const Box selected = Box::Intersection(selection.GetBox(), box_);
+    if (selected.IsEmpty() || dim_y_ == 0) {
+      return;
+    }
+    selected_ = Layout(RowAt(selected.y_min - box_.y_min),
+                       RowAt(selected.y_max - box_.y_min));
+    selected_->Select(selection);
+  }
+
+  std::string GetSelectedContent(Selection& selection) override {
+    return selected_ ? selected_->GetSelectedContent(selection) : "";
+  }
+
+  void Render(Screen& screen) override {
+    const Box visible = Box::Intersection(box_, screen.stencil);
+    if (visible.IsEmpty() || dim_y_ == 0) {
+      return;
+    }
+
+    Layout(RowAt(visible.y_min - box_.y_min),
+           RowAt(visible.y_max - box_.y_min))
+        ->Render(screen);
+
+    // Draw the selected rows again, over the others. They were materialized
+    // separately, and hold the selection.
+    if (selected_) {
+      selected_->Render(screen);
+    }
+  }
+
+ private:
+  // Materialize the rows [y_min, y_max] of the grid, and lay them out at their
+  // position in the table.
+  Element Layout(int y_min, int y_max) const {
+    std::vector<Elements> lines = materialize_(y_min, y_max);
+    for (int y = y_min; y <= y_max; ++y) {
+      auto& line = lines[y - y_min];
+      for (int x = 0; x < int(line.size()); ++x) {
+        Element& element = line[x];
+        // Give every row and column the same size, whatever the rows
+        // materialized.
+        if (x % 2 == 1 || y % 2 == 1) {
+          element = std::move(element) | size(WIDTH, EQUAL, sizes_[x]) |
+                    size(HEIGHT, EQUAL, Height(y));
+        }
+        element = GridElement(std::move(element), x, y);
+      }
+    }
+    Element grid = gridbox(std::move(lines));
+
+    Box box = box_;
+    box.y_min = box_.y_min + Top(y_min);
+    box.y_max = box_.y_min + Top(y_max) + Height(y_max) - 1;
+
+    // Lay out the materialized rows, like ftxui::Render() does for the whole
+    // document.
+    Status status;
+    grid->CachedCheck(&status);
+    const int max_iterations = 20;
+    while (status.need_iteration && status.iteration < max_iterations) {
+      grid->CachedComputeRequirement();
+      grid->CachedSetBox(box);
+      status.need_iteration = false;
+      status.iteration++;
+      grid->CachedCheck(&status);
+    }
+    return grid;
+  }
+
+  // The vertical position of the row |y| of the grid, relative to the table.
+  int Top(int y) const {
+    int top = y / 2;
+    for (const auto& [min, max] : tall_separators_) {
+      if (min >= y) {
+        break;
+      }
+      top += EvenCount(min, std::min(max, y - 1));
+    }
+    return top;
+  }
+
+  int Height(int y) const {
+    if (y % 2 == 1) {
+      return 1;
+    }
+    for (const auto& [min, max] : tall_separators_) {
+      if (min <= y && y <= max) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  // The last row of the grid starting at, or above |top|.
+  int RowAt(int top) const {
+    int min = 0;
+    int max = dim_y_ - 1;
+    while (min < max) {
+      const int middle = (min + max + 1) / 2;
+      if (Top(middle) <= top) {
+        min = middle;
+      } else {
+        max = middle - 1;
+      }
+    }
+    return min;
+  }
+
+  Materialize materialize_;
+  std::vector<int> widths_;
+  // The flex of the columns, set by the decorations of their cells.
+  std::vector<int> flex_grow_;
+  // The width of the columns, once laid out.
+  std::vector<int> sizes_;
+  int flex_grow_x_ = 0;
+  int flex_shrink_x_ = 0;
+  int dim_y_;
+  // The ranges of rows of the grid whose separators are one cell tall.
+  std::vector<std::pair<int, int>> tall_separators_;
+
+  // The rows holding the selection, if any.
+  Element selected_;
+};
+
 }  // namespace
 
 /// @brief Create an empty table.
@@ -85,6 +296,30 @@ Table::Table(std::initializer_list<std::vector<std::string>> init) {
   Initialize(std::move(input));
 }
 
+/// @brief Create a virtualized table. The cells are pulled from |cell| on
+/// every frame, only for the rows visible on the screen. The rows are one cell
+/// tall.
+/// @param columns The number of columns.
+/// @param rows The number of rows.
+/// @param cell Return the element of a given cell.
+/// @see SetColumnWidths
+Table::Table(int columns,
+             int rows,
+             std::function<Element(int column, int row)> cell)
+    : cell_(std::move(cell)) {
+  input_dim_x_ = columns;
+  input_dim_y_ = rows;
+  dim_x_ = 2 * input_dim_x_ + 1;
+  dim_y_ = 2 * input_dim_y_ + 1;
+}
+
+/// @brief Set the width of the columns of a virtualized table. By default,
+/// they are measured on a sample of the rows. Wider cells are truncated.
+/// @param widths The width of each column.
+void Table::SetColumnWidths(std::vector<int> widths) {
+  column_widths_ = std::move(widths);
+}
+
 // private
 void Table::Initialize(std::vector<std::vector<Element>> input) {
   input_dim_y_ = static_cast<int>(input.size());
@@ -210,29 +445,196 @@ TableSelection Table::SelectAll() {
 /// @brief Render the table.
 /// @return The rendered table. This is an element you can draw.
 Element Table::Render() {
+  if (cell_) {
+    return RenderVirtual();
+  }
   for (int y = 0; y < dim_y_; ++y) {
     for (int x = 0; x < dim_x_; ++x) {
       auto& it = elements_[y][x];
+      it = GridElement(std::move(it), x, y);
+    }
+  }
+  dim_x_ = 0;
+  dim_y_ = 0;
+  return gridbox(std::move(elements_));
+}
 
-      // Line
-      if ((x + y) % 2 == 1) {
-        it = std::move(it) | flex;
-        continue;
-      }
+// private
+// Build the rows [y_min, y_max] of the grid of a virtualized table, as a
+// regular table. Apply the recorded operations, or only the |operation|-th one.
+Table Table::Materialize(int y_min, int y_max, int operation) const {
+  Table window;
+  window.input_dim_x_ = input_dim_x_;
+  window.input_dim_y_ = input_dim_y_;
+  window.dim_x_ = dim_x_;
+  window.dim_y_ = dim_y_;
+  window.y_begin_ = y_min;
+  window.elements_.clear();
+  window.elements_.resize(y_max - y_min + 1);
+  for (int y = y_min; y <= y_max; ++y) {
+    auto& line = window.elements_[y - y_min];
+    line.reserve(dim_x_);
+    for (int x = 0; x < dim_x_; ++x) {
+      Element element = IsCell(x, y) ? cell_(x / 2, y / 2) : nullptr;
+      line.push_back(element ? std::move(element) : emptyElement());
+    }
+  }
 
-      // Cells
-      if ((x % 2) == 1 && (y % 2) == 1) {
-        it = std::move(it) | flex_shrink;
-        continue;
+  for (int i = 0; i < int(operations_.size()); ++i) {
+    const Operation& op = operations_[i];
+    if ((operation == -1 || operation == i) && op.y_min <= y_max &&
+        y_min <= op.y_max) {
+      op.apply(window);
+    }
+  }
+  return window;
+}
+
+// private
+Element Table::RenderVirtual() {
+  std::vector<int> widths(dim_x_, 0);
+  std::vector<std::pair<int, int>> tall_separators;
+
+  // Like in a gridbox, a column is as flexible as its least flexible cell.
+  std::vector<int> flex_grow(dim_x_, -1);
+  std::vector<int> flex_shrink(dim_x_, -1);
+  auto merge_flex = [](int& flex, int cell) {
+    flex = (flex == -1) ? cell : std::min(flex, cell);
+  };
+
+  // Measure the size of the elements of the rows [y_min, y_max].
+  auto measure = [&](int y_min, int y_max, int operation,
+                     std::vector<bool>* tall) {
+    Table window = Materialize(y_min, y_max, operation);
+    for (int y = y_min; y <= y_max; ++y) {
+      for (int x = 0; x < dim_x_; ++x) {
+        // The corners are drawn over the lines, and take no space.
+        if (x % 2 == 0 && y % 2 == 0) {
+          continue;
+        }
+        Element& element = window.elements_[y - y_min][x];
+        element->ComputeRequirement();
+        const Requirement requirement = element->requirement();
+        if (operation == -1 || x % 2 == 0) {
+          widths[x] = std::max(widths[x], requirement.min_x);
+        }
+        if (operation == -1 && IsCell(x, y)) {
+          merge_flex(flex_grow[x], requirement.flex_grow_x);
+          merge_flex(flex_shrink[x], requirement.flex_shrink_x);
+        }
+        if (tall && y % 2 == 0 && requirement.min_y > 0) {
+          (*tall)[y - y_min] = true;
+        }
       }
+    }
+  };
+
+  // The columns are measured on a sample of the rows, unless provided.
+  if (int(column_widths_.size()) < input_dim_x_) {
+    const int samples = std::min(input_dim_y_, 64);  // NOLINT
+    for (int i = 0; i < samples; ++i) {
+      const int row =
+          samples == 1
+              ? 0
+              : int(int64_t(i) * (input_dim_y_ - 1) / (samples - 1));
+      measure(2 * row, 2 * row + 2, -1, nullptr);
+    }
+  } else if (input_dim_y_ != 0) {
+    // Only the flex of the columns is needed. Take it from the first row.
+    measure(0, 2, -1, nullptr);
+  }
+  for (int i = 0; i < int(column_widths_.size()) && i < input_dim_x_; ++i) {
+    widths[2 * i + 1] = column_widths_[i];
+  }
 
-      // Corners
-      it = std::move(it) | size(WIDTH, EQUAL, 0) | size(HEIGHT, EQUAL, 0);
+  // The separators drawn by each operation depend only on whether the row is
+  // on its border, and on the parity of the row. Materialize the first and
+  // the last rows of each operation to find them.
+  for (int i = 0; i < int(operations_.size()); ++i) {
+    const int y_min = operations_[i].y_min;
+    const int y_max = operations_[i].y_max;
+    const int first_max = std::min(y_max, y_min + 2);
+    const int last_min = std::max(y_min, y_max - 2);
+    std::vector<bool> first(first_max - y_min + 1, false);
+    std::vector<bool> last(y_max - last_min + 1, false);
+    measure(y_min, first_max, i, &first);
+    measure(last_min, y_max, i, &last);
+    if (first.front()) {
+      tall_separators.emplace_back(y_min, y_min);
+    }
+    if (last.back()) {
+      tall_separators.emplace_back(y_max, y_max);
+    }
+    const int inside = (y_min % 2 == 0) ? y_min + 2 : y_min + 1;
+    if (inside < y_max && first[inside - y_min]) {
+      tall_separators.emplace_back(y_min + 1, y_max - 1);
     }
   }
-  dim_x_ = 0;
-  dim_y_ = 0;
-  return gridbox(std::move(elements_));
+
+  // Merge the overlapping ranges.
+  std::sort(tall_separators.begin(), tall_separators.end());
+  std::vector<std::pair<int, int>> merged;
+  for (const auto& range : tall_separators) {
+    if (!merged.empty() && range.first <= merged.back().second + 1) {
+      merged.back().second = std::max(merged.back().second, range.second);
+    } else {
+      merged.push_back(range);
+    }
+  }
+
+  const int dim_y = dim_y_;
+  auto table = std::make_shared<Table>(std::move(*this));
+  auto materialize = [table](int y_min, int y_max) {
+    return std::move(table->Materialize(y_min, y_max).elements_);
+  };
+  for (int x = 0; x < dim_x_; ++x) {
+    flex_grow[x] = std::max(flex_grow[x], 0);
+    flex_shrink[x] = std::max(flex_shrink[x], 0);
+  }
+  return MakeNode<VirtualTable>(std::move(materialize), std::move(widths),
+                                std::move(flex_grow), std::move(flex_shrink),
+                                dim_y, std::move(merged));
+}
+
+// private
+// Virtualized tables record the operation, to apply it later on the rows
+// materialized for rendering.
+bool TableSelection::Defer(std::function<void(TableSelection&)> operation) {
+  if (!table_->cell_) {
+    return false;
+  }
+  table_->operations_.push_back({
+      y_min_,
+      y_max_,
+      [selection = *this, operation = std::move(operation)](
+          Table& table) mutable {
+        selection.table_ = &table;
+        operation(selection);
+      },
+  });
+  return true;
+}
+
+// private
+// Whether the row |y| is materialized by the table.
+bool TableSelection::Holds(int y) const {
+  return table_->y_begin_ <= y &&
+         y < table_->y_begin_ + int(table_->elements_.size());
+}
+
+// private
+int TableSelection::ClipMin(int y) const {
+  return std::max(y, table_->y_begin_);
+}
+
+// private
+int TableSelection::ClipMax(int y) const {
+  return std::min(y, table_->y_begin_ + int(table_->elements_.size()) - 1);
+}
+
+// private
+Element& TableSelection::At(int x, int y) {
+  return table_->elements_[y - table_->y_begin_][x];
 }
 
 /// @brief Apply the `decorator` to the selection.
@@ -240,9 +642,12 @@ Element Table::Render() {
 /// @param decorator The decorator to apply.
 // NOLINTNEXTLINE
 void TableSelection::Decorate(Decorator decorator) {
-  for (int y = y_min_; y <= y_max_; ++y) {
+  if (Defer([decorator](TableSelection& s) { s.Decorate(decorator); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); ++y) {
     for (int x = x_min_; x <= x_max_; ++x) {
-      Element& e = table_->elements_[y][x];
+      Element& e = At(x, y);
       e = std::move(e) | decorator;
     }
   }
@@ -253,10 +658,13 @@ void TableSelection::Decorate(Decorator decorator) {
 /// This decorate only the cells.
 // NOLINTNEXTLINE
 void TableSelection::DecorateCells(Decorator decorator) {
-  for (int y = y_min_; y <= y_max_; ++y) {
+  if (Defer([decorator](TableSelection& s) { s.DecorateCells(decorator); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); ++y) {
     for (int x = x_min_; x <= x_max_; ++x) {
       if (y % 2 == 1 && x % 2 == 1) {
-        Element& e = table_->elements_[y][x];
+        Element& e = At(x, y);
         e = std::move(e) | decorator;
       }
     }
@@ -272,10 +680,15 @@ void TableSelection::DecorateCells(Decorator decorator) {
 void TableSelection::DecorateAlternateColumn(Decorator decorator,
                                              int modulo,
                                              int shift) {
-  for (int y = y_min_; y <= y_max_; ++y) {
+  if (Defer([=](TableSelection& s) {
+        s.DecorateAlternateColumn(decorator, modulo, shift);
+      })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); ++y) {
     for (int x = x_min_; x <= x_max_; ++x) {
       if (y % 2 == 1 && (x / 2) % modulo == shift) {
-        Element& e = table_->elements_[y][x];
+        Element& e = At(x, y);
         e = std::move(e) | decorator;
       }
     }
@@ -291,10 +704,15 @@ void TableSelection::DecorateAlternateColumn(Decorator decorator,
 void TableSelection::DecorateAlternateRow(Decorator decorator,
                                           int modulo,
                                           int shift) {
-  for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
+  if (Defer([=](TableSelection& s) {
+        s.DecorateAlternateRow(decorator, modulo, shift);
+      })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_ + 1); y <= ClipMax(y_max_ - 1); ++y) {
     for (int x = x_min_; x <= x_max_; ++x) {
       if (y % 2 == 1 && (y / 2) % modulo == shift) {
-        Element& e = table_->elements_[y][x];
+        Element& e = At(x, y);
         e = std::move(e) | decorator;
       }
     }
@@ -310,10 +728,15 @@ void TableSelection::DecorateAlternateRow(Decorator decorator,
 void TableSelection::DecorateCellsAlternateColumn(Decorator decorator,
                                                   int modulo,
                                                   int shift) {
-  for (int y = y_min_; y <= y_max_; ++y) {
+  if (Defer([=](TableSelection& s) {
+        s.DecorateCellsAlternateColumn(decorator, modulo, shift);
+      })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); ++y) {
     for (int x = x_min_; x <= x_max_; ++x) {
       if (y % 2 == 1 && x % 2 == 1 && ((x / 2) % modulo == shift)) {
-        Element& e = table_->elements_[y][x];
+        Element& e = At(x, y);
         e = std::move(e) | decorator;
       }
     }
@@ -329,10 +752,15 @@ void TableSelection::DecorateCellsAlternateColumn(Decorator decorator,
 void TableSelection::DecorateCellsAlternateRow(Decorator decorator,
                                                int modulo,
                                                int shift) {
-  for (int y = y_min_; y <= y_max_; ++y) {
+  if (Defer([=](TableSelection& s) {
+        s.DecorateCellsAlternateRow(decorator, modulo, shift);
+      })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); ++y) {
     for (int x = x_min_; x <= x_max_; ++x) {
       if (y % 2 == 1 && x % 2 == 1 && ((y / 2) % modulo == shift)) {
-        Element& e = table_->elements_[y][x];
+        Element& e = At(x, y);
         e = std::move(e) | decorator;
       }
     }
@@ -342,28 +770,38 @@ void TableSelection::DecorateCellsAlternateRow(Decorator decorator,
 /// @brief Apply a `border` around the selection.
 /// @param border The border style to apply.
 void TableSelection::Border(BorderStyle border) {
+  if (Defer([border](TableSelection& s) { s.Border(border); })) {
+    return;
+  }
   BorderLeft(border);
   BorderRight(border);
   BorderTop(border);
   BorderBottom(border);
 
-  // NOLINTNEXTLINE
-  table_->elements_[y_min_][x_min_] = text(charset[border][0]) | automerge;
-  // NOLINTNEXTLINE
-  table_->elements_[y_min_][x_max_] = text(charset[border][1]) | automerge;
-  // NOLINTNEXTLINE
-  table_->elements_[y_max_][x_min_] = text(charset[border][2]) | automerge;
-  // NOLINTNEXTLINE
-  table_->elements_[y_max_][x_max_] = text(charset[border][3]) | automerge;
+  if (Holds(y_min_)) {
+    // NOLINTNEXTLINE
+    At(x_min_, y_min_) = text(charset[border][0]) | automerge;
+    // NOLINTNEXTLINE
+    At(x_max_, y_min_) = text(charset[border][1]) | automerge;
+  }
+  if (Holds(y_max_)) {
+    // NOLINTNEXTLINE
+    At(x_min_, y_max_) = text(charset[border][2]) | automerge;
+    // NOLINTNEXTLINE
+    At(x_max_, y_max_) = text(charset[border][3]) | automerge;
+  }
 }
 
 /// @brief Draw some separator lines in the selection.
 /// @param border The border style to apply.
 void TableSelection::Separator(BorderStyle border) {
-  for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
+  if (Defer([border](TableSelection& s) { s.Separator(border); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_ + 1); y <= ClipMax(y_max_ - 1); ++y) {
     for (int x = x_min_ + 1; x <= x_max_ - 1; ++x) {
       if (y % 2 == 0 || x % 2 == 0) {
-        Element& e = table_->elements_[y][x];
+        Element& e = At(x, y);
         e = (y % 2 == 1)
                 ? separatorCharacter(charset[border][5]) | automerge   // NOLINT
                 : separatorCharacter(charset[border][4]) | automerge;  // NOLINT
@@ -375,10 +813,13 @@ void TableSelection::Separator(BorderStyle border) {
 /// @brief Draw some vertical separator lines in the selection.
 /// @param border The border style to apply.
 void TableSelection::SeparatorVertical(BorderStyle border) {
-  for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
+  if (Defer([border](TableSelection& s) { s.SeparatorVertical(border); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_ + 1); y <= ClipMax(y_max_ - 1); ++y) {
     for (int x = x_min_ + 1; x <= x_max_ - 1; ++x) {
       if (x % 2 == 0) {
-        table_->elements_[y][x] =
+        At(x, y) =
             separatorCharacter(charset[border][5]) | automerge;  // NOLINT
       }
     }
@@ -388,10 +829,13 @@ void TableSelection::SeparatorVertical(BorderStyle border) {
 /// @brief Draw some horizontal separator lines in the selection.
 /// @param border The border style to apply.
 void TableSelection::SeparatorHorizontal(BorderStyle border) {
-  for (int y = y_min_ + 1; y <= y_max_ - 1; ++y) {
+  if (Defer([border](TableSelection& s) { s.SeparatorHorizontal(border); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_ + 1); y <= ClipMax(y_max_ - 1); ++y) {
     for (int x = x_min_ + 1; x <= x_max_ - 1; ++x) {
       if (y % 2 == 0) {
-        table_->elements_[y][x] =
+        At(x, y) =
             separatorCharacter(charset[border][4]) | automerge;  // NOLINT
       }
     }
@@ -401,8 +845,11 @@ void TableSelection::SeparatorHorizontal(BorderStyle border) {
 /// @brief Draw some separator lines to the left side of the selection.
 /// @param border The border style to apply.
 void TableSelection::BorderLeft(BorderStyle border) {
-  for (int y = y_min_; y <= y_max_; y++) {
-    table_->elements_[y][x_min_] =
+  if (Defer([border](TableSelection& s) { s.BorderLeft(border); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); y++) {
+    At(x_min_, y) =
         separatorCharacter(charset[border][5]) | automerge;  // NOLINT
   }
 }
@@ -410,8 +857,11 @@ void TableSelection::BorderLeft(BorderStyle border) {
 /// @brief Draw some separator lines to the right side of the selection.
 /// @param border The border style to apply.
 void TableSelection::BorderRight(BorderStyle border) {
-  for (int y = y_min_; y <= y_max_; y++) {
-    table_->elements_[y][x_max_] =
+  if (Defer([border](TableSelection& s) { s.BorderRight(border); })) {
+    return;
+  }
+  for (int y = ClipMin(y_min_); y <= ClipMax(y_max_); y++) {
+    At(x_max_, y) =
         separatorCharacter(charset[border][5]) | automerge;  // NOLINT
   }
 }
@@ -419,8 +869,14 @@ void TableSelection::BorderRight(BorderStyle border) {
 /// @brief Draw some separator lines to the top side of the selection.
 /// @param border The border style to apply.
 void TableSelection::BorderTop(BorderStyle border) {
+  if (Defer([border](TableSelection& s) { s.BorderTop(border); })) {
+    return;
+  }
+  if (!Holds(y_min_)) {
+    return;
+  }
   for (int x = x_min_; x <= x_max_; x++) {
-    table_->elements_[y_min_][x] =
+    At(x, y_min_) =
         separatorCharacter(charset[border][4]) | automerge;  // NOLINT
   }
 }
@@ -428,8 +884,14 @@ void TableSelection::BorderTop(BorderStyle border) {
 /// @brief Draw some separator lines to the bottom side of the selection.
 /// @param border The border style to apply.
 void TableSelection::BorderBottom(BorderStyle border) {
+  if (Defer([border](TableSelection& s) { s.BorderBottom(border); })) {
+    return;
+  }
+  if (!Holds(y_max_)) {
+    return;
+  }
   for (int x = x_min_; x <= x_max_; x++) {
-    table_->elements_[y_max_][x] =
+    At(x, y_max_) =
         separatorCharacter(charset[border][4]) | automerge;  // NOLINT
   }
 }
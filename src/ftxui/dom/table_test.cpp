@@ -2,9 +2,13 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>
+#include <functional>  // for function
+#include <string>      // for string, to_string
+#include <vector>      // for vector
 
 #include "ftxui/dom/elements.hpp"  // for LIGHT, flex, center, EMPTY, DOUBLE
 #include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/dom/selection.hpp"  // for Selection
 #include "ftxui/dom/table.hpp"
 #include "ftxui/screen/screen.hpp"  // for Screen
 
@@ -745,5 +749,145 @@ TEST(TableTest, Issue912) {
   });
 }
 
+TEST(TableTest, VirtualSameAsTable) {
+  const std::vector<std::vector<std::string>> data = {
+      {"Name", "Size", "Kind"},        {"a.txt", "1", "Text"},
+      {"image.png", "4096", "Image"},  {"b", "12", "Text"},
+      {"movie.mp4", "1000000", "Video"}, {"c", "0", "Empty"},
+  };
+  const std::vector<std::function<void(Table&)>> decorations = {
+      [](Table&) {},
+      [](Table& t) { t.SelectAll().Border(LIGHT); },
+      [](Table& t) {
+        t.SelectAll().Border(DOUBLE);
+        t.SelectAll().Separator(LIGHT);
+        t.SelectRow(0).Decorate(bold);
+      },
+      [](Table& t) {
+        t.SelectAll().SeparatorVertical(LIGHT);
+        t.SelectRow(0).BorderBottom(HEAVY);
+        t.SelectRows(1, -1).DecorateCellsAlternateRow(inverted);
+      },
+      [](Table& t) {
+        t.SelectAll().Border(LIGHT);
+        t.SelectColumn(1).Border(HEAVY);
+        t.SelectRow(2).Border(HEAVY);
+        t.SelectCell(2, 4).Border(ROUNDED);
+      },
+      [](Table& t) {
+        t.SelectRectangle(0, 1, 1, 3).Border(LIGHT);
+        t.SelectColumns(1, 2).SeparatorHorizontal(DASHED);
+        t.SelectColumn(-1).DecorateCells(center);
+      },
+  };
+
+  for (size_t i = 0; i < decorations.size(); ++i) {
+    auto table = Table(data);
+    decorations[i](table);
+
+    auto virtual_table = Table(3, int(data.size()), [&](int x, int y) {
+      return text(data[y][x]);
+    });
+    decorations[i](virtual_table);
+
+    auto expected_element = table.Render();
+    auto element = virtual_table.Render();
+    for (int width : {30, 15}) {
+      Screen expected(width, 16);
+      Render(expected, expected_element);
+      Screen screen(width, 16);
+      Render(screen, element);
+      EXPECT_EQ(expected.ToString(), screen.ToString())
+          << "decoration " << i << ", width " << width;
+    }
+  }
+}
+
+TEST(TableTest, VirtualColumnFlex) {
+  const std::vector<std::vector<std::string>> data = {
+      {"a", "b", "c"},
+      {"d", "e", "f"},
+      {"g", "h", "i"},
+  };
+  auto decorate = [](Table& t) {
+    t.SelectAll().Border(LIGHT);
+    t.SelectAll().Separator(LIGHT);
+    t.SelectColumn(1).Decorate(flex);
+  };
+  auto table = Table(data);
+  decorate(table);
+  auto virtual_table = Table(3, int(data.size()), [&](int x, int y) {
+    return text(data[y][x]);
+  });
+  decorate(virtual_table);
+
+  Screen expected(20, 7);
+  Render(expected, table.Render());
+  Screen screen(20, 7);
+  Render(screen, virtual_table.Render());
+  EXPECT_EQ(expected.ToString(), screen.ToString());
+  EXPECT_EQ(
+      "┌─┬──────────────┬─┐\r\n"
+      "│a│b             │c│\r\n"
+      "├─┼──────────────┼─┤\r\n"
+      "│d│e             │f│\r\n"
+      "├─┼──────────────┼─┤\r\n"
+      "│g│h             │i│\r\n"
+      "└─┴──────────────┴─┘",
+      screen.ToString());
+}
+
+TEST(TableTest, VirtualSelection) {
+  const std::vector<std::vector<std::string>> data = {
+      {"Name", "Size"},
+      {"a.txt", "1"},
+      {"image.png", "4096"},
+      {"b", "12"},
+  };
+  auto table = Table(data);
+  table.SelectAll().Border(LIGHT);
+  auto virtual_table = Table(2, int(data.size()), [&](int x, int y) {
+    return text(data[y][x]);
+  });
+  virtual_table.SelectAll().Border(LIGHT);
+
+  auto expected_element = table.Render();
+  auto element = virtual_table.Render();
+  Screen expected(20, 6);
+  Selection expected_selection(3, 2, 5, 3);
+  Render(expected, expected_element.get(), expected_selection);
+  Screen screen(20, 6);
+  Selection selection(3, 2, 5, 3);
+  Render(screen, element.get(), selection);
+
+  EXPECT_EQ(selection.GetParts(), "txt1\nimage");
+  EXPECT_EQ(expected_selection.GetParts(), selection.GetParts());
+  EXPECT_EQ(expected.ToString(), screen.ToString());
+}
+
+TEST(TableTest, VirtualLarge) {
+  int cells = 0;
+  auto table = Table(2, 1000000, [&](int x, int y) {
+    cells++;
+    return text(x == 0 ? std::to_string(y) : "row");
+  });
+  table.SetColumnWidths({7, 3});
+  table.SelectAll().Border(LIGHT);
+  table.SelectAll().SeparatorVertical(LIGHT);
+  auto document = table.Render() | focusPositionRelative(0.f, 0.5f) | yframe;
+
+  cells = 0;
+  Screen screen(13, 5);
+  Render(screen, document);
+  EXPECT_LT(cells, 20);
+  EXPECT_EQ(
+      "│499998 │row│\r\n"
+      "│499999 │row│\r\n"
+      "│500000 │row│\r\n"
+      "│500001 │row│\r\n"
+      "│500002 │row│",
+      screen.ToString());
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -1,12 +1,13 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for min
-#include <memory>     // for make_shared
-#include <sstream>
-#include <string>   // for string, wstring
-#include <utility>  // for move
+#include <algorithm>    // for min
+#include <cstdint>      // for uint32_t
+#include <string>       // for string, wstring
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
+#include "ftxui/dom/arena.hpp"        // for MakeNode
 #include "ftxui/dom/deprecated.hpp"   // for text, vtext
 #include "ftxui/dom/elements.hpp"     // for Element, text, vtext
 #include "ftxui/dom/node.hpp"         // for Node
@@ -14,19 +15,41 @@
 #include "ftxui/dom/selection.hpp"    // for Selection
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Pixel, Screen
-#include "ftxui/screen/string.hpp"  // for string_width, Utf8ToGlyphs, to_string
+#include "ftxui/screen/string.hpp"  // for to_string
+#include "ftxui/screen/string_internal.hpp"  // for Utf8ToPackedGlyphs
 
 namespace ftxui {
 
 namespace {
 using ftxui::Screen;
 
+// The glyphs of a string, computed once and shared in between
+// ComputeRequirement, Select and Render.
+class Glyphs {
+ public:
+  explicit Glyphs(const std::string& text) {
+    Utf8ToPackedGlyphs(text, &glyphs_, &offsets_);
+  }
+
+  int size() const { return int(offsets_.size()) - 1; }
+
+  std::string_view operator[](int index) const {
+    const uint32_t begin = offsets_[index];    // NOLINT
+    const uint32_t end = offsets_[index + 1];  // NOLINT
+    return {glyphs_.data() + begin, end - begin};
+  }
+
+ private:
+  std::string glyphs_;
+  std::vector<uint32_t> offsets_;
+};
+
 class Text : public Node {
  public:
-  explicit Text(std::string text) : text_(std::move(text)) {}
+  explicit Text(const std::string& text) : glyphs_(text) {}
 
   void ComputeRequirement() override {
-    requirement_.min_x = string_width(text_);
+    requirement_.min_x = glyphs_.size();
     requirement_.min_y = 1;
     has_selection = false;
   }
@@ -42,18 +65,19 @@ class Text : public Node {
     selection_start_ = selection_saturated.GetBox().x_min;
     selection_end_ = selection_saturated.GetBox().x_max;
 
-    std::stringstream ss;
+    std::string selected;
     int x = box_.x_min;
-    for (const auto& cell : Utf8ToGlyphs(text_)) {
+    for (int i = 0; i < glyphs_.size(); ++i) {
+      const std::string_view cell = glyphs_[i];
       if (cell == "\n") {
         continue;
       }
       if (selection_start_ <= x && x <= selection_end_) {
-        ss << cell;
+        selected += cell;
       }
       x++;
     }
-    selection.AddPart(ss.str(), box_.y_min, selection_start_, selection_end_);
+    selection.AddPart(selected, box_.y_min, selection_start_, selection_end_);
   }
 
   void Render(Screen& screen) override {
@@ -64,19 +88,21 @@ class Text : public Node {
       return;
     }
 
-    for (const auto& cell : Utf8ToGlyphs(text_)) {
+    for (int i = 0; i < glyphs_.size(); ++i) {
       if (x > box_.x_max) {
         break;
       }
+      const std::string_view cell = glyphs_[i];
       if (cell == "\n") {
         continue;
       }
-      screen.PixelAt(x, y).character = cell;
+      Pixel& pixel = screen.PixelAt(x, y);
+      pixel.character.assign(cell.data(), cell.size());
 
       if (has_selection) {
         auto selectionTransform = screen.GetSelectionStyle();
         if ((x >= selection_start_) && (x <= selection_end_)) {
-          selectionTransform(screen.PixelAt(x, y));
+          selectionTransform(pixel);
         }
       }
 
@@ -85,7 +111,7 @@ class Text : public Node {
   }
 
  private:
-  std::string text_;
+  Glyphs glyphs_;
   bool has_selection = false;
   int selection_start_ = 0;
   int selection_end_ = -1;
@@ -93,12 +119,12 @@ class Text : public Node {
 
 class VText : public Node {
  public:
-  explicit VText(std::string text)
-      : text_(std::move(text)), width_{std::min(string_width(text_), 1)} {}
+  explicit VText(const std::string& text)
+      : glyphs_(text), width_{std::min(glyphs_.size(), 1)} {}
 
   void ComputeRequirement() override {
     requirement_.min_x = width_;
-    requirement_.min_y = string_width(text_);
+    requirement_.min_y = glyphs_.size();
   }
 
   void Render(Screen& screen) override {
@@ -107,17 +133,18 @@ class VText : public Node {
     if (x + width_ - 1 > box_.x_max) {
       return;
     }
-    for (const auto& it : Utf8ToGlyphs(text_)) {
+    for (int i = 0; i < glyphs_.size(); ++i) {
       if (y > box_.y_max) {
         return;
       }
-      screen.PixelAt(x, y).character = it;
+      const std::string_view cell = glyphs_[i];
+      screen.PixelAt(x, y).character.assign(cell.data(), cell.size());
       y += 1;
     }
   }
 
  private:
-  std::string text_;
+  Glyphs glyphs_;
   int width_ = 1;
 };
 
@@ -139,7 +166,7 @@ class VText : public Node {
 /// Hello world!
 /// ```
 Element text(std::string text) {
-  return std::make_shared<Text>(std::move(text));
+  return MakeNode<Text>(text);
 }
 
 /// @brief Display a piece of unicode text.
@@ -158,7 +185,7 @@ Element text(std::string text) {
 /// Hello world!
 /// ```
 Element text(std::wstring text) {  // NOLINT
-  return std::make_shared<Text>(to_string(text));
+  return MakeNode<Text>(to_string(text));
 }
 
 /// @brief Display a piece of unicode text vertically.
@@ -188,7 +215,7 @@ Element text(std::wstring text) {  // NOLINT
 /// !
 /// ```
 Element vtext(std::string text) {
-  return std::make_shared<VText>(std::move(text));
+  return MakeNode<VText>(text);
 }
 
 /// @brief Display a piece unicode text vertically.
@@ -218,7 +245,7 @@ Element vtext(std::string text) {
 /// !
 /// ```
 Element vtext(std::wstring text) {  // NOLINT
-  return std::make_shared<VText>(to_string(text));
+  return MakeNode<VText>(to_string(text));
 }
 
 }  // namespace ftxui
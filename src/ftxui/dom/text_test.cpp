@@ -87,6 +87,17 @@ TEST(TextTest, CJK_3) {
       screen.ToString());
 }
 
+TEST(TextTest, RepeatedGlyphs) {
+  auto element = text("测测é─测ééa测─") | border;
+  Screen screen(18, 3);
+  Render(screen, element);
+  EXPECT_EQ(
+      "╭────────────────╮\r\n"
+      "│测测é─测ééa测─  │\r\n"
+      "╰────────────────╯",
+      screen.ToString());
+}
+
 TEST(TextTest, CombiningCharacters) {
   const std::string t =
       // Combining above:
@@ -99,10 +99,10 @@ Dimensions Dimension::Fit(Element& e, bool extend_beyond_screen) {
   box.y_max = fullsize.dimy;
 
   Node::Status status;
-  e->Check(&status);
+  e->CachedCheck(&status);
   const int max_iteration = 20;
   while (status.need_iteration && status.iteration < max_iteration) {
-    e->ComputeRequirement();
+    e->CachedComputeRequirement();
 
     // Don't give the element more space than it needs:
     box.x_max = std::min(box.x_max, e->requirement().min_x);
@@ -111,10 +111,10 @@ Dimensions Dimension::Fit(Element& e, bool extend_beyond_screen) {
       box.y_max = std::min(box.y_max, fullsize.dimy);
     }
 
-    e->SetBox(box);
+    e->CachedSetBox(box);
     status.need_iteration = false;
     status.iteration++;
-    e->Check(&status);
+    e->CachedCheck(&status);
 
     if (!status.need_iteration) {
       break;
@@ -1,18 +1,21 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for max
+#include <algorithm>  // for max, upper_bound
 #include <cstddef>    // for size_t
-#include <memory>  // for __shared_ptr_access, shared_ptr, make_shared, allocator_traits<>::value_type
+#include <memory>  // for __shared_ptr_access, shared_ptr, allocator_traits<>::value_type
 #include <utility>  // for move
 #include <vector>   // for vector, __alloc_traits<>::value_type
 
+#include "ftxui/dom/arena.hpp"        // for MakeNode
 #include "ftxui/dom/box_helper.hpp"   // for Element, Compute
 #include "ftxui/dom/elements.hpp"     // for Element, Elements, vbox
 #include "ftxui/dom/node.hpp"         // for Node, Elements
+#include "ftxui/dom/render_pool.hpp"  // for RenderPool
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/dom/selection.hpp"    // for Selection
 #include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Screen
 
 namespace ftxui {
 
@@ -26,18 +29,18 @@ class VBox : public Node {
     requirement_ = Requirement{};
 
     for (auto& child : children_) {
-      child->ComputeRequirement();
+      child->CachedComputeRequirement();
+      const Requirement requirement = child->requirement();
 
       // Propagate the focused requirement.
-      if (requirement_.focused.Prefer(child->requirement().focused)) {
-        requirement_.focused = child->requirement().focused;
+      if (requirement_.focused.Prefer(requirement.focused)) {
+        requirement_.focused = requirement.focused;
         requirement_.focused.box.Shift(0, requirement_.min_y);
       }
 
       // Extend the min_x and min_y to contain all the children
-      requirement_.min_y += child->requirement().min_y;
-      requirement_.min_x =
-          std::max(requirement_.min_x, child->requirement().min_x);
+      requirement_.min_y += requirement.min_y;
+      requirement_.min_x = std::max(requirement_.min_x, requirement.min_x);
     }
   }
 
@@ -55,13 +58,38 @@ class VBox : public Node {
     const int target_size = box.y_max - box.y_min + 1;
     box_helper::Compute(&elements, target_size);
 
+    // Every child is given a box, even the ones outside of the screen, because
+    // reflect() and focus rely on them.
+    y_.resize(children_.size() + 1);
     int y = box.y_min;
     for (size_t i = 0; i < children_.size(); ++i) {
+      y_[i] = y;
       box.y_min = y;
       box.y_max = y + elements[i].size - 1;
-      children_[i]->SetBox(box);
+      children_[i]->CachedSetBox(box);
       y = box.y_max + 1;
     }
+    y_[children_.size()] = y;
+  }
+
+  void Render(Screen& screen) override {
+    if (y_.size() != children_.size() + 1) {
+      Node::Render(screen);
+      return;
+    }
+
+    // The children are laid out in order. Render only the ones intersecting
+    // the stencil. In a frame, this is proportional to the visible part only.
+    const int stencil_min = screen.stencil.y_min;
+    const int stencil_max = screen.stencil.y_max;
+    const auto first = std::upper_bound(y_.begin() + 1, y_.end(), stencil_min);
+    const size_t begin = first - (y_.begin() + 1);
+    size_t end = begin;
+    while (end < children_.size() && y_[end] <= stencil_max) {
+      ++end;
+    }
+    RenderPool::RenderChildren(screen, children_.data() + begin,
+                               children_.data() + end);
   }
 
   void Select(Selection& selection) override {
@@ -77,6 +105,9 @@ class VBox : public Node {
       child->Select(selection_saturated);
     }
   }
+
+  // The y coordinate of every child, followed by the end of the last one.
+  std::vector<int> y_;
 };
 }  // namespace
 
@@ -94,7 +125,7 @@ class VBox : public Node {
 /// });
 /// ```
 Element vbox(Elements children) {
-  return std::make_shared<VBox>(std::move(children));
+  return MakeNode<VBox>(std::move(children));
 }
 
 }  // namespace ftxui
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 #include <algorithm>  // for remove
 #include <cstddef>    // for size_t
+#include <memory>     // for make_shared
 #include <string>     // for string, allocator, basic_string
 #include <vector>     // for vector
 
@@ -15,6 +16,19 @@
 namespace ftxui {
 namespace {
 
+// Count the number of times it is rendered.
+class RenderCounter : public Node {
+ public:
+  explicit RenderCounter(int* count) : count_(count) {}
+
+  void ComputeRequirement() override { requirement_.min_y = 1; }
+
+  void Render(Screen& /*screen*/) override { ++*count_; }
+
+ private:
+  int* count_;
+};
+
 std::string rotate(std::string str) {
   str.erase(std::remove(str.begin(), str.end(), '\r'), str.end());
   str.erase(std::remove(str.begin(), str.end(), '\n'), str.end());
@@ -368,5 +382,22 @@ TEST(VBoxText, FlexGrow_NoFlex_FlewShrink) {
   }
 }
 
+// Only the children visible in the frame are rendered.
+TEST(VBoxTest, FrameCulling) {
+  int count = 0;
+  Elements children;
+  for (int i = 0; i < 1000; ++i) {
+    children.push_back(std::make_shared<RenderCounter>(&count));
+  }
+  children[500] = text("focused") | focus;
+  auto root = vbox(std::move(children)) | yframe;
+
+  Screen screen(10, 5);
+  Render(screen, root);
+  EXPECT_EQ(count, 4);
+  EXPECT_EQ(rotate(screen.ToString()),
+            std::string(20, ' ') + "focused" + std::string(23, ' '));
+}
+
 }  // namespace ftxui
 // NOLINTEND
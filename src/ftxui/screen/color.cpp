@@ -3,8 +3,9 @@
 // the LICENSE file.
 #include "ftxui/screen/color.hpp"
 
-#include <array>  // for array
-#include <cmath>
+#include <algorithm>  // for min
+#include <array>      // for array
+#include <cmath>      // for powf, nextafter
 #include <cstdint>
 #include <string>
 
@@ -32,6 +33,159 @@ const std::array<const char*, 33> palette16code = {
     "97", "107",  //
 };
 
+// The decimal representation of a uint8_t.
+struct Decimal {
+  std::array<char, 3> data;
+  std::uint8_t size;
+};
+
+constexpr std::array<Decimal, 256> BuildDecimals() {
+  std::array<Decimal, 256> out{};
+  for (int i = 0; i < 256; ++i) {
+    Decimal& decimal = out[i];  // NOLINT
+    if (i >= 100) {
+      decimal.data[decimal.size++] = char('0' + i / 100);       // NOLINT
+    }
+    if (i >= 10) {
+      decimal.data[decimal.size++] = char('0' + i / 10 % 10);  // NOLINT
+    }
+    decimal.data[decimal.size++] = char('0' + i % 10);  // NOLINT
+  }
+  return out;
+}
+
+// Precomputed, so that printing a color never formats numbers at runtime.
+constexpr std::array<Decimal, 256> decimals = BuildDecimals();
+
+void AppendDecimal(std::string& out, std::uint8_t value) {
+  const Decimal& decimal = decimals[value];  // NOLINT
+  out.append(decimal.data.data(), decimal.size);
+}
+
+// The Palette256 colors from 16 to 231 form a 6x6x6 cube, followed by 24
+// grays. The nearest color in the cube is made of the nearest level for each
+// channel. The nearest gray only depends on the sum of the channels.
+constexpr std::array<int, 6> cube_levels = {0, 95, 135, 175, 215, 255};
+constexpr int cube_begin = 16;
+constexpr int gray_begin = 232;
+constexpr int gray_count = 24;
+
+struct PaletteTables {
+  std::array<std::uint8_t, 256> cube{};          // Indexed by channel.
+  std::array<std::uint8_t, 3 * 255 + 1> gray{};  // Indexed by r + g + b.
+};
+
+constexpr PaletteTables BuildPaletteTables() {
+  PaletteTables out{};
+  for (int value = 0; value < 256; ++value) {
+    int best_distance = 256 * 256;
+    for (int i = 0; i < 6; ++i) {
+      const int d = value - cube_levels[i];  // NOLINT
+      if (d * d < best_distance) {
+        best_distance = d * d;
+        out.cube[value] = std::uint8_t(i);  // NOLINT
+      }
+    }
+  }
+  for (int sum = 0; sum <= 3 * 255; ++sum) {
+    // Minimize the distance to (v, v, v): 3 v^2 - 2 v sum + constant.
+    int best_distance = 3 * 256 * 256;
+    for (int i = 0; i < gray_count; ++i) {
+      const int v = 8 + 10 * i;  // NOLINT
+      const int distance = 3 * v * v - 2 * v * sum;
+      if (distance < best_distance) {
+        best_distance = distance;
+        out.gray[sum] = std::uint8_t(i);  // NOLINT
+      }
+    }
+  }
+  return out;
+}
+
+constexpr PaletteTables palette_tables = BuildPaletteTables();
+
+int Distance(int index, int red, int green, int blue) {
+  const ColorInfo info = GetColorInfo(Color::Palette256(index));
+  const int dr = info.red - red;
+  const int dg = info.green - green;
+  const int db = info.blue - blue;
+  return dr * dr + dg * dg + db * db;
+}
+
+// The Palette256 color nearest to an RGB color, from 16 to 255. On ties, the
+// lowest index wins.
+int NearestPalette256(int red, int green, int blue) {
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+  const int cube = cube_begin + 36 * palette_tables.cube[red] +
+                   6 * palette_tables.cube[green] + palette_tables.cube[blue];
+  const int gray = gray_begin + palette_tables.gray[red + green + blue];
+  // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+  return Distance(gray, red, green, blue) < Distance(cube, red, green, blue)
+             ? gray
+             : cube;
+}
+
+// Gamma correction: https://en.wikipedia.org/wiki/Gamma_correction
+// The channels are converted to the linear space with a table. The way back
+// is a search of the linear value among the thresholds where
+// powf(value, 1 / gamma) reaches the next integer, so that the result is the
+// same as truncating it. A table of 4096 buckets of the linear space gives
+// the starting point of the search.
+struct GammaTables {
+  static constexpr float gamma = 2.2F;
+  static constexpr int buckets = 4096;
+
+  GammaTables() {  // NOLINT
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+    for (int i = 0; i < 256; ++i) {
+      to_linear[i] = powf(float(i), gamma);
+    }
+    thresholds[0] = 0.F;
+    for (int i = 1; i < 256; ++i) {
+      float threshold = to_linear[i];
+      while (powf(threshold, 1.F / gamma) >= float(i)) {
+        threshold = std::nextafter(threshold, 0.F);
+      }
+      while (powf(threshold, 1.F / gamma) < float(i)) {
+        threshold = std::nextafter(threshold, to_linear[255] * 2.F);
+      }
+      thresholds[i] = threshold;
+    }
+    bucket_size = to_linear[255] / float(buckets);
+    int channel = 0;
+    for (int i = 0; i < buckets; ++i) {
+      while (channel < 255 &&
+             thresholds[channel + 1] <= float(i) * bucket_size) {
+        ++channel;
+      }
+      from_linear[i] = std::uint8_t(channel);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+  }
+
+  std::uint8_t FromLinear(float value) const {
+    if (!(value > 0.F)) {
+      return 0;
+    }
+    const int bucket = std::min(int(value / bucket_size), buckets - 1);
+    int channel = from_linear[bucket];  // NOLINT
+    while (channel < 255 && thresholds[channel + 1] <= value) {  // NOLINT
+      ++channel;
+    }
+    return std::uint8_t(channel);
+  }
+
+  std::array<float, 256> to_linear;
+  std::array<float, 256> thresholds;
+  std::array<std::uint8_t, buckets> from_linear;
+  float bucket_size;
+};
+
+const GammaTables& Gamma() {
+  static const GammaTables tables;
+  return tables;
+}
+
 }  // namespace
 
 bool Color::operator==(const Color& rhs) const {
@@ -44,33 +198,36 @@ bool Color::operator!=(const Color& rhs) const {
 }
 
 std::string Color::Print(bool is_background_color) const {
-  if (is_background_color) {
-    switch (type_) {
-      case ColorType::Palette1:
-        return "49";
-      case ColorType::Palette16:
-        return palette16code[2 * red_ + 1];  // NOLINT
-      case ColorType::Palette256:
-        return "48;5;" + std::to_string(red_);
-      case ColorType::TrueColor:
-        return "48;2;" + std::to_string(red_) + ";" + std::to_string(green_) +
-               ";" + std::to_string(blue_);
-    }
-  } else {
-    switch (type_) {
-      case ColorType::Palette1:
-        return "39";
-      case ColorType::Palette16:
-        return palette16code[2 * red_];  // NOLINT
-      case ColorType::Palette256:
-        return "38;5;" + std::to_string(red_);
-      case ColorType::TrueColor:
-        return "38;2;" + std::to_string(red_) + ";" + std::to_string(green_) +
-               ";" + std::to_string(blue_);
-    }
+  std::string out;
+  Print(is_background_color, out);
+  return out;
+}
+
+/// @brief Append the SGR parameters selecting this color to `out`.
+/// @param is_background_color Whether to select the background color, as
+/// opposed to the foreground color.
+/// @param out The string to append to.
+void Color::Print(bool is_background_color, std::string& out) const {
+  switch (type_) {
+    case ColorType::Palette1:
+      out += is_background_color ? "49" : "39";
+      return;
+    case ColorType::Palette16:
+      out += palette16code[2 * red_ + int(is_background_color)];  // NOLINT
+      return;
+    case ColorType::Palette256:
+      out += is_background_color ? "48;5;" : "38;5;";
+      AppendDecimal(out, red_);
+      return;
+    case ColorType::TrueColor:
+      out += is_background_color ? "48;2;" : "38;2;";
+      AppendDecimal(out, red_);
+      out += ';';
+      AppendDecimal(out, green_);
+      out += ';';
+      AppendDecimal(out, blue_);
+      return;
   }
-  // NOTREACHED();
-  return "";
 }
 
 /// @brief Build a transparent color.
@@ -110,24 +267,7 @@ Color::Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
     return;
   }
 
-  // Find the closest Color from the database:
-  const int max_distance = 256 * 256 * 3;
-  int closest = max_distance;
-  int best = 0;
-  const int database_begin = 16;
-  const int database_end = 256;
-  for (int i = database_begin; i < database_end; ++i) {
-    const ColorInfo color_info = GetColorInfo(Color::Palette256(i));
-    const int dr = color_info.red - red;
-    const int dg = color_info.green - green;
-    const int db = color_info.blue - blue;
-    const int dist = dr * dr + dg * dg + db * db;
-    if (closest > dist) {
-      closest = dist;
-      best = i;
-    }
-  }
-
+  const int best = NearestPalette256(red, green, blue);
   if (Terminal::ColorSupport() == Terminal::Color::Palette256) {
     type_ = ColorType::Palette256;
     red_ = best;
@@ -252,15 +392,14 @@ Color Color::Interpolate(float t, const Color& a, const Color& b) {
   get_color(a, &a_r, &a_g, &a_b);
   get_color(b, &b_r, &b_g, &b_b);
 
-  // Gamma correction:
-  // https://en.wikipedia.org/wiki/Gamma_correction
-  auto interp = [t](uint8_t a_u, uint8_t b_u) {
-    constexpr float gamma = 2.2F;
-    const float a_f = powf(a_u, gamma);
-    const float b_f = powf(b_u, gamma);
+  // Interpolate in the linear space. See GammaTables.
+  const GammaTables& gamma = Gamma();
+  auto interp = [t, &gamma](uint8_t a_u, uint8_t b_u) {
+    const float a_f = gamma.to_linear[a_u];  // NOLINT
+    const float b_f = gamma.to_linear[b_u];  // NOLINT
     const float c_f = a_f * (1.0F - t) +  //
                       b_f * t;
-    return static_cast<uint8_t>(powf(c_f, 1.F / gamma));
+    return gamma.FromLinear(c_f);
   };
   return Color::RGB(interp(a_r, b_r),   //
                     interp(a_g, b_g),   //
@@ -3,6 +3,9 @@
 // the LICENSE file.
 #include "ftxui/screen/color.hpp"
 #include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include "ftxui/screen/color_info.hpp"
 #include "ftxui/screen/terminal.hpp"
 
 namespace ftxui {
@@ -31,6 +34,17 @@ TEST(ColorTest, PrintTrueCOlor) {
   EXPECT_EQ(Color::RGB(1, 2, 3).Print(true), "48;2;1;2;3");
 }
 
+TEST(ColorTest, PrintAppend) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  std::string out = "\x1B[";
+  Color::RGB(0, 99, 255).Print(false, out);
+  out += ";";
+  Color(Color::DarkRed).Print(true, out);
+  out += ";";
+  Color(Color::Red).Print(true, out);
+  EXPECT_EQ(out, "\x1B[38;2;0;99;255;48;5;52;41");
+}
+
 TEST(ColorTest, FallbackTo256) {
   Terminal::SetColorSupport(Terminal::Color::Palette256);
   EXPECT_EQ(Color::RGB(1, 2, 3).Print(false), "38;5;16");
@@ -41,6 +55,45 @@ TEST(ColorTest, FallbackTo16) {
   EXPECT_EQ(Color::RGB(1, 2, 3).Print(false), "30");
 }
 
+namespace {
+// The nearest color in the Palette256 database, by scanning it.
+int NearestPalette256(int red, int green, int blue) {
+  int closest = 256 * 256 * 3;
+  int best = 0;
+  for (int i = 16; i < 256; ++i) {
+    const ColorInfo info = GetColorInfo(Color::Palette256(i));
+    const int dr = info.red - red;
+    const int dg = info.green - green;
+    const int db = info.blue - blue;
+    const int dist = dr * dr + dg * dg + db * db;
+    if (closest > dist) {
+      closest = dist;
+      best = i;
+    }
+  }
+  return best;
+}
+}  // namespace
+
+TEST(ColorTest, FallbackToNearest) {
+  for (int red = 0; red < 256; red += 3) {
+    for (int green = 0; green < 256; green += 5) {
+      for (int blue = 0; blue < 256; blue += 1) {
+        const int best = NearestPalette256(red, green, blue);
+        Terminal::SetColorSupport(Terminal::Color::Palette256);
+        ASSERT_EQ(Color::RGB(red, green, blue).Print(false),
+                  "38;5;" + std::to_string(best))
+            << red << " " << green << " " << blue;
+        Terminal::SetColorSupport(Terminal::Color::Palette16);
+        const auto index_16 = GetColorInfo(Color::Palette256(best)).index_16;
+        ASSERT_EQ(Color::RGB(red, green, blue).Print(false),
+                  Color(Color::Palette16(index_16)).Print(false))
+            << red << " " << green << " " << blue;
+      }
+    }
+  }
+}
+
 TEST(ColorTest, Litterals) {
   Terminal::SetColorSupport(Terminal::Color::TrueColor);
   using namespace ftxui::literals;
@@ -78,6 +131,32 @@ TEST(ColorTest, Interpolate) {
             "38;2;251;198;225");
 }
 
+// The gamma correction uses lookup tables. The result must be the same as
+// computing it with powf.
+TEST(ColorTest, InterpolateSameAsPowf) {
+  Terminal::SetColorSupport(Terminal::Color::TrueColor);
+  auto interp = [](float t, int a, int b) {
+    const float a_f = powf(float(a), 2.2F);
+    const float b_f = powf(float(b), 2.2F);
+    const float c_f = a_f * (1.0F - t) + b_f * t;
+    return int(static_cast<uint8_t>(powf(c_f, 1.F / 2.2F)));
+  };
+  for (float t : {0.F, 0.01F, 0.1F, 0.3F, 0.5F, 0.7F, 0.99F, 1.F}) {
+    for (int a = 0; a < 256; ++a) {
+      for (int b = 0; b < 256; ++b) {
+        const int c = interp(t, a, b);
+        const int d = interp(t, b, 255 - a);
+        ASSERT_EQ(Color::Interpolate(t, Color::RGB(a, b, a),
+                                     Color::RGB(b, 255 - a, b))
+                      .Print(false),
+                  "38;2;" + std::to_string(c) + ";" + std::to_string(d) +
+                      ";" + std::to_string(c))
+            << t << " " << a << " " << b;
+      }
+    }
+  }
+}
+
 TEST(ColorTest, HSV) {
   Terminal::SetColorSupport(Terminal::Color::TrueColor);
   EXPECT_EQ(Color::HSV(0, 255, 255).Print(false), "38;2;255;0;0");
@@ -1,7 +1,8 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <sstream>  // IWYU pragma: keep
+#include <algorithm>  // for fill
+#include <sstream>    // IWYU pragma: keep
 #include <string>
 #include <vector>
 
@@ -11,8 +12,10 @@
 namespace ftxui {
 
 namespace {
+// Pixels drawn outside of the stencil land here. One per thread, because
+// independent parts of a screen can be rendered in parallel.
 Pixel& dev_null_pixel() {
-  static Pixel pixel;
+  thread_local Pixel pixel;
   return pixel;
 }
 }  // namespace
@@ -21,7 +24,13 @@ Image::Image(int dimx, int dimy)
     : stencil{0, dimx - 1, 0, dimy - 1},
       dimx_(dimx),
       dimy_(dimy),
-      pixels_(dimy, std::vector<Pixel>(dimx)) {}
+      pixels_(dimx * dimy) {}
+
+Image::Image(Image& target, Box area)
+    : stencil(Box::Intersection(area, target.stencil)),
+      dimx_(target.dimx_),
+      dimy_(target.dimy_),
+      target_(target.target_ != nullptr ? target.target_ : &target) {}
 
 /// @brief Access a character in a cell at a given position.
 /// @param x The cell position along the x-axis.
@@ -41,23 +50,28 @@ const std::string& Image::at(int x, int y) const {
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 Pixel& Image::PixelAt(int x, int y) {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  if (!stencil.Contain(x, y)) {
+    return dev_null_pixel();
+  }
+  return (target_ != nullptr ? target_->pixels_ : pixels_)[y * dimx_ + x];
 }
 
 /// @brief Access a cell (Pixel) at a given position.
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 const Pixel& Image::PixelAt(int x, int y) const {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  if (!stencil.Contain(x, y)) {
+    return dev_null_pixel();
+  }
+  return (target_ != nullptr ? target_->pixels_ : pixels_)[y * dimx_ + x];
 }
 
 /// @brief Clear all the pixel from the screen.
 void Image::Clear() {
-  for (auto& line : pixels_) {
-    for (auto& cell : line) {
-      cell = Pixel();
-    }
-  }
+  // Copy-assign from a single default pixel, so that every cell reuses the
+  // storage of its `character`.
+  const Pixel default_pixel;
+  std::fill(pixels_.begin(), pixels_.end(), default_pixel);
 }
 
 }  // namespace ftxui
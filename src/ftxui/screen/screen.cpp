@@ -1,13 +1,18 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <cstddef>  // for size_t
-#include <cstdint>
+#include <algorithm>  // for min
+#include <array>      // for array
+#include <charconv>   // for to_chars
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <cstring>    // for memcpy
 #include <iostream>  // for operator<<, stringstream, basic_ostream, flush, cout, ostream
 #include <limits>
-#include <map>      // for _Rb_tree_const_iterator, map, operator!=, operator==
 #include <sstream>  // IWYU pragma: keep
-#include <utility>  // for pair
+#include <string>   // for string
+#include <utility>  // for pair, swap
+#include <vector>   // for vector
 
 #include "ftxui/screen/image.hpp"  // for Image
 #include "ftxui/screen/pixel.hpp"  // for Pixel
@@ -70,88 +75,167 @@ void WindowsEmulateVT100Terminal() {
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 void UpdatePixelStyle(const Screen* screen,
-                      std::stringstream& ss,
+                      std::string& out,
                       const Pixel& prev,
                       const Pixel& next) {
   // See https://gist.github.com/egmontkob/eb114294efbcd5adb1944c9f3cb5feda
   if (FTXUI_UNLIKELY(next.hyperlink != prev.hyperlink)) {
-    ss << "\x1B]8;;" << screen->Hyperlink(next.hyperlink) << "\x1B\\";
+    out += "\x1B]8;;";
+    out += screen->Hyperlink(next.hyperlink);
+    out += "\x1B\\";
   }
 
   // Bold
   if (FTXUI_UNLIKELY((next.bold ^ prev.bold) | (next.dim ^ prev.dim))) {
     // BOLD_AND_DIM_RESET:
-    ss << ((prev.bold && !next.bold) || (prev.dim && !next.dim) ? "\x1B[22m"
-                                                                : "");
-    ss << (next.bold ? "\x1B[1m" : "");  // BOLD_SET
-    ss << (next.dim ? "\x1B[2m" : "");   // DIM_SET
+    out += ((prev.bold && !next.bold) || (prev.dim && !next.dim) ? "\x1B[22m"
+                                                                 : "");
+    out += (next.bold ? "\x1B[1m" : "");  // BOLD_SET
+    out += (next.dim ? "\x1B[2m" : "");   // DIM_SET
   }
 
   // Underline
   if (FTXUI_UNLIKELY(next.underlined != prev.underlined ||
                      next.underlined_double != prev.underlined_double)) {
-    ss << (next.underlined          ? "\x1B[4m"     // UNDERLINE
-           : next.underlined_double ? "\x1B[21m"    // UNDERLINE_DOUBLE
-                                    : "\x1B[24m");  // UNDERLINE_RESET
+    out += (next.underlined          ? "\x1B[4m"     // UNDERLINE
+            : next.underlined_double ? "\x1B[21m"    // UNDERLINE_DOUBLE
+                                     : "\x1B[24m");  // UNDERLINE_RESET
   }
 
   // Blink
   if (FTXUI_UNLIKELY(next.blink != prev.blink)) {
-    ss << (next.blink ? "\x1B[5m"     // BLINK_SET
-                      : "\x1B[25m");  // BLINK_RESET
+    out += (next.blink ? "\x1B[5m"     // BLINK_SET
+                       : "\x1B[25m");  // BLINK_RESET
   }
 
   // Inverted
   if (FTXUI_UNLIKELY(next.inverted != prev.inverted)) {
-    ss << (next.inverted ? "\x1B[7m"     // INVERTED_SET
-                         : "\x1B[27m");  // INVERTED_RESET
+    out += (next.inverted ? "\x1B[7m"     // INVERTED_SET
+                          : "\x1B[27m");  // INVERTED_RESET
   }
 
   // Italics
   if (FTXUI_UNLIKELY(next.italic != prev.italic)) {
-    ss << (next.italic ? "\x1B[3m"     // ITALIC_SET
-                       : "\x1B[23m");  // ITALIC_RESET
+    out += (next.italic ? "\x1B[3m"     // ITALIC_SET
+                        : "\x1B[23m");  // ITALIC_RESET
   }
 
   // StrikeThrough
   if (FTXUI_UNLIKELY(next.strikethrough != prev.strikethrough)) {
-    ss << (next.strikethrough ? "\x1B[9m"     // CROSSED_OUT
-                              : "\x1B[29m");  // CROSSED_OUT_RESET
+    out += (next.strikethrough ? "\x1B[9m"     // CROSSED_OUT
+                               : "\x1B[29m");  // CROSSED_OUT_RESET
   }
 
   if (FTXUI_UNLIKELY(next.foreground_color != prev.foreground_color ||
                      next.background_color != prev.background_color)) {
-    ss << "\x1B[" + next.foreground_color.Print(false) + "m";
-    ss << "\x1B[" + next.background_color.Print(true) + "m";
+    out += "\x1B[";
+    next.foreground_color.Print(false, out);
+    out += "m\x1B[";
+    next.background_color.Print(true, out);
+    out += "m";
   }
 }
 
+// Append the decimal representation of a positive number.
+void AppendNumber(std::string& out, int value) {
+  std::array<char, 12> buffer{};
+  const auto result =
+      std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  out.append(buffer.data(), result.ptr);
+}
+
+// Return whether two pixels, possibly owned by two different screens, are
+// displayed identically on the terminal.
+bool SamePixel(const Screen& a_screen,
+               const Pixel& a,
+               const Screen& b_screen,
+               const Pixel& b) {
+  return a.character == b.character &&                  //
+         a.foreground_color == b.foreground_color &&    //
+         a.background_color == b.background_color &&    //
+         a.bold == b.bold &&                            //
+         a.dim == b.dim &&                              //
+         a.italic == b.italic &&                        //
+         a.inverted == b.inverted &&                    //
+         a.underlined == b.underlined &&                //
+         a.underlined_double == b.underlined_double &&  //
+         a.blink == b.blink &&                          //
+         a.strikethrough == b.strikethrough &&          //
+         a_screen.Hyperlink(a.hyperlink) == b_screen.Hyperlink(b.hyperlink);
+}
+
+// Whether the glyph of |pixel| covers two cells. The fullwidth codepoints are
+// all encoded with 3 or 4 bytes, so the common ASCII and 2-byte glyphs are
+// recognized without measuring them.
+bool IsFullWidth(const Pixel& pixel) {
+  const std::string& character = pixel.character;
+  if (character.size() <= 1) {
+    return false;
+  }
+  if (character.size() == 2 && uint8_t(character[0]) >= 0xC0) {  // NOLINT
+    return false;
+  }
+  return string_width(character) == 2;
+}
+
+// Remember whether the glyphs measured are fullwidth. The single codepoint
+// glyphs are packed in an integer, and looked up in a small direct-mapped
+// table: CJK and emoji texts only use a few distinct glyphs per screen. The
+// longer grapheme clusters only remember the last one measured.
+class FullWidthCache {
+ public:
+  bool IsFullWidth(const Pixel& pixel) {
+    const std::string& character = pixel.character;
+    if (character.size() <= 2) {
+      return ftxui::IsFullWidth(pixel);
+    }
+
+    if (character.size() <= 4) {
+      // The first byte isn't zero, so no glyph packs to the empty key.
+      uint32_t key = 0;
+      std::memcpy(&key, character.data(), character.size());
+      Entry& entry = entries_[(key * 2654435761U) >> (32 - kBits)];  // NOLINT
+      if (entry.key != key) {
+        entry.key = key;
+        entry.fullwidth = string_width(character) == 2;
+      }
+      return entry.fullwidth;
+    }
+
+    if (character != glyph_) {
+      glyph_ = character;
+      fullwidth_ = string_width(character) == 2;
+    }
+    return fullwidth_;
+  }
+
+ private:
+  static constexpr int kBits = 8;
+  struct Entry {
+    uint32_t key = 0;
+    bool fullwidth = false;
+  };
+  std::array<Entry, 1 << kBits> entries_{};
+
+  std::string glyph_;
+  bool fullwidth_ = false;
+};
+
 struct TileEncoding {
   std::uint8_t left : 2;
   std::uint8_t top : 2;
   std::uint8_t right : 2;
   std::uint8_t down : 2;
   std::uint8_t round : 1;
+};
 
-  // clang-format off
-  bool operator<(const TileEncoding& other) const {
-    if (left < other.left)   { return  true;  }
-    if (left > other.left)   { return  false; }
-    if (top < other.top)     { return  true;  }
-    if (top > other.top)     { return  false; }
-    if (right < other.right) { return  true;  }
-    if (right > other.right) { return  false; }
-    if (down < other.down)   { return  true;  }
-    if (down > other.down)   { return  false; }
-    if (round < other.round) { return  true;  }
-    if (round > other.round) { return  false; }
-      return false;
-  }
-  // clang-format on
+struct TileDefinition {
+  const char* character;
+  TileEncoding encoding;
 };
 
 // clang-format off
-const std::map<std::string, TileEncoding> tile_encoding = { // NOLINT
+constexpr TileDefinition tile_definitions[] = {
     {"─", {1, 0, 1, 0, 0}},
     {"━", {2, 0, 2, 0, 0}},
     {"╍", {2, 0, 2, 0, 0}},
@@ -294,73 +378,129 @@ const std::map<std::string, TileEncoding> tile_encoding = { // NOLINT
 };
 // clang-format on
 
-template <class A, class B>
-std::map<B, A> InvertMap(const std::map<A, B> input) {
-  std::map<B, A> output;
-  for (const auto& it : input) {
-    output[it.second] = it.first;
+// The box drawing characters are in the range U+2500 to U+257F. In UTF-8,
+// they are encoded as "E2 94 80" up to "E2 95 BF". Return the index of the
+// character in this range, or -1 if it isn't part of it.
+constexpr int TileIndex(const char* character, std::size_t size) {
+  if (size != 3) {
+    return -1;
   }
-  return output;
+  const auto b0 = static_cast<std::uint8_t>(character[0]);  // NOLINT
+  const auto b1 = static_cast<std::uint8_t>(character[1]);  // NOLINT
+  const auto b2 = static_cast<std::uint8_t>(character[2]);  // NOLINT
+  if (b0 != 0xE2 || (b1 != 0x94 && b1 != 0x95) || b2 < 0x80 || b2 > 0xBF) {
+    return -1;
+  }
+  return ((b1 - 0x94) << 6) | (b2 - 0x80);  // NOLINT
+}
+
+// Pack a TileEncoding into an index of 9 bits.
+constexpr int TileKey(TileEncoding encoding) {
+  return encoding.left | (encoding.top << 2) | (encoding.right << 4) |  //
+         (encoding.down << 6) | (encoding.round << 8);                  // NOLINT
 }
 
-const std::map<TileEncoding, std::string> tile_encoding_inverse =  // NOLINT
-    InvertMap(tile_encoding);
+struct TileTables {
+  // The encoding of every tile, indexed by TileIndex().
+  std::array<TileEncoding, 128> encoding{};
+  std::array<bool, 128> valid{};
+
+  // The TileIndex() of the tile for every TileKey(), or -1 if none.
+  std::array<std::int8_t, 512> index{};
+};
+
+constexpr TileTables BuildTileTables() {
+  TileTables tables{};
+  for (auto& index : tables.index) {
+    index = -1;
+  }
+  for (const TileDefinition& definition : tile_definitions) {
+    std::size_t size = 0;
+    while (definition.character[size] != 0) {  // NOLINT
+      ++size;
+    }
+    const int index = TileIndex(definition.character, size);
+    tables.encoding[index] = definition.encoding;  // NOLINT
+    tables.valid[index] = true;                    // NOLINT
+
+    // When several characters share an encoding, keep the last codepoint.
+    std::int8_t& inverse = tables.index[TileKey(definition.encoding)];  // NOLINT
+    if (index > inverse) {
+      inverse = static_cast<std::int8_t>(index);
+    }
+  }
+  return tables;
+}
+
+constexpr TileTables tile_tables = BuildTileTables();
+
+// Return the TileIndex() of a pixel, or -1 if it isn't a known tile.
+int TileIndex(const std::string& character) {
+  const int index = TileIndex(character.data(), character.size());
+  return (index >= 0 && tile_tables.valid[index]) ? index : -1;  // NOLINT
+}
+
+// Replace the tile `character`, with the tile whose encoding is `encoding`, if
+// any.
+void SetTile(std::string& character, TileEncoding encoding) {
+  const int index = tile_tables.index[TileKey(encoding)];  // NOLINT
+  if (index < 0) {
+    return;
+  }
+  // Only the last two bytes differ in between tiles.
+  character[1] = static_cast<char>(0x94 + (index >> 6));    // NOLINT
+  character[2] = static_cast<char>(0x80 + (index & 0x3F));  // NOLINT
+}
 
 void UpgradeLeftRight(std::string& left, std::string& right) {
-  const auto it_left = tile_encoding.find(left);
-  if (it_left == tile_encoding.end()) {
+  const int index_left = TileIndex(left);
+  if (index_left < 0) {
     return;
   }
-  const auto it_right = tile_encoding.find(right);
-  if (it_right == tile_encoding.end()) {
+  const int index_right = TileIndex(right);
+  if (index_right < 0) {
     return;
   }
 
-  if (it_left->second.right == 0 && it_right->second.left != 0) {
-    TileEncoding encoding_left = it_left->second;
-    encoding_left.right = it_right->second.left;
-    const auto it_left_upgrade = tile_encoding_inverse.find(encoding_left);
-    if (it_left_upgrade != tile_encoding_inverse.end()) {
-      left = it_left_upgrade->second;
-    }
+  const TileEncoding tile_left = tile_tables.encoding[index_left];    // NOLINT
+  const TileEncoding tile_right = tile_tables.encoding[index_right];  // NOLINT
+
+  if (tile_left.right == 0 && tile_right.left != 0) {
+    TileEncoding encoding_left = tile_left;
+    encoding_left.right = tile_right.left;
+    SetTile(left, encoding_left);
   }
 
-  if (it_right->second.left == 0 && it_left->second.right != 0) {
-    TileEncoding encoding_right = it_right->second;
-    encoding_right.left = it_left->second.right;
-    const auto it_right_upgrade = tile_encoding_inverse.find(encoding_right);
-    if (it_right_upgrade != tile_encoding_inverse.end()) {
-      right = it_right_upgrade->second;
-    }
+  if (tile_right.left == 0 && tile_left.right != 0) {
+    TileEncoding encoding_right = tile_right;
+    encoding_right.left = tile_left.right;
+    SetTile(right, encoding_right);
   }
 }
 
 void UpgradeTopDown(std::string& top, std::string& down) {
-  const auto it_top = tile_encoding.find(top);
-  if (it_top == tile_encoding.end()) {
+  const int index_top = TileIndex(top);
+  if (index_top < 0) {
     return;
   }
-  const auto it_down = tile_encoding.find(down);
-  if (it_down == tile_encoding.end()) {
+  const int index_down = TileIndex(down);
+  if (index_down < 0) {
     return;
   }
 
-  if (it_top->second.down == 0 && it_down->second.top != 0) {
-    TileEncoding encoding_top = it_top->second;
-    encoding_top.down = it_down->second.top;
-    const auto it_top_down = tile_encoding_inverse.find(encoding_top);
-    if (it_top_down != tile_encoding_inverse.end()) {
-      top = it_top_down->second;
-    }
+  const TileEncoding tile_top = tile_tables.encoding[index_top];    // NOLINT
+  const TileEncoding tile_down = tile_tables.encoding[index_down];  // NOLINT
+
+  if (tile_top.down == 0 && tile_down.top != 0) {
+    TileEncoding encoding_top = tile_top;
+    encoding_top.down = tile_down.top;
+    SetTile(top, encoding_top);
   }
 
-  if (it_down->second.top == 0 && it_top->second.down != 0) {
-    TileEncoding encoding_down = it_down->second;
-    encoding_down.top = it_top->second.down;
-    const auto it_down_top = tile_encoding_inverse.find(encoding_down);
-    if (it_down_top != tile_encoding_inverse.end()) {
-      down = it_down_top->second;
-    }
+  if (tile_down.top == 0 && tile_top.down != 0) {
+    TileEncoding encoding_down = tile_down;
+    encoding_down.top = tile_top.down;
+    SetTile(down, encoding_down);
   }
 }
 
@@ -409,44 +549,160 @@ Screen::Screen(int dimx, int dimy) : Image{dimx, dimy} {
 #endif
 }
 
+Screen::Screen(Screen& target, Box area) : Image{target, area} {}
+
+void Screen::SwapPixels(Screen& other) {
+  pixels_.swap(other.pixels_);
+  hyperlinks_.swap(other.hyperlinks_);
+  std::swap(dimx_, other.dimx_);
+  std::swap(dimy_, other.dimy_);
+
+  // The pixels received have the wrong dimensions. Allocate new ones.
+  if (dimx_ != other.dimx_ || dimy_ != other.dimy_) {
+    dimx_ = other.dimx_;
+    dimy_ = other.dimy_;
+    pixels_ = std::vector<Pixel>(dimx_ * dimy_);
+  }
+}
+
 /// Produce a std::string that can be used to print the Screen on the
 /// terminal.
 /// @note Don't forget to flush stdout. Alternatively, you can use
 /// Screen::Print();
 std::string Screen::ToString() const {
-  std::stringstream ss;
+  std::string output;
+  ToString(output);
+  return output;
+}
 
+/// Same as ToString(), but append the result to `output`. Reusing the same
+/// `output` across frames reuses its capacity and avoids allocations.
+/// @param output The string to append to.
+void Screen::ToString(std::string& output) const {
   const Pixel default_pixel;
   const Pixel* previous_pixel_ref = &default_pixel;
+  FullWidthCache widths;
 
   for (int y = 0; y < dimy_; ++y) {
     // New line in between two lines.
     if (y != 0) {
-      UpdatePixelStyle(this, ss, *previous_pixel_ref, default_pixel);
+      UpdatePixelStyle(this, output, *previous_pixel_ref, default_pixel);
       previous_pixel_ref = &default_pixel;
-      ss << "\r\n";
+      output += "\r\n";
     }
 
     // After printing a fullwith character, we need to skip the next cell.
     bool previous_fullwidth = false;
-    for (const auto& pixel : pixels_[y]) {
+    const Pixel* line = pixels_.data() + y * dimx_;
+    for (int x = 0; x < dimx_; ++x) {
+      const Pixel& pixel = line[x];
       if (!previous_fullwidth) {
-        UpdatePixelStyle(this, ss, *previous_pixel_ref, pixel);
+        UpdatePixelStyle(this, output, *previous_pixel_ref, pixel);
         previous_pixel_ref = &pixel;
         if (pixel.character.empty()) {
-          ss << " ";
+          output += ' ';
         } else {
-          ss << pixel.character;
+          output += pixel.character;
         }
       }
-      previous_fullwidth = (string_width(pixel.character) == 2);
+      previous_fullwidth = widths.IsFullWidth(pixel);
+    }
+  }
+
+  // Reset the style to default:
+  UpdatePixelStyle(this, output, *previous_pixel_ref, default_pixel);
+}
+
+/// Produce a std::string updating the terminal from the content of `previous`
+/// into the content of this screen. Only the cells that changed are printed,
+/// using cursor movements to jump over the unchanged ones.
+///
+/// The terminal cursor is expected to be on the top-left cell of the screen,
+/// with the default style. On return, it is left where ToString() would have
+/// left it: after the last cell of the last line.
+///
+/// If the dimensions of the two screens differ, this is equivalent to
+/// ToString().
+/// @param previous The content currently displayed by the terminal.
+std::string Screen::ToString(const Screen& previous) const {
+  std::string output;
+  ToString(previous, output);
+  return output;
+}
+
+/// Same as ToString(const Screen&), but append the result to `output`.
+/// Reusing the same `output` across frames reuses its capacity and avoids
+/// allocations.
+/// @param previous The content currently displayed by the terminal.
+/// @param output The string to append to.
+void Screen::ToString(const Screen& previous, std::string& output) const {
+  if (previous.dimx_ != dimx_ || previous.dimy_ != dimy_) {
+    ToString(output);
+    return;
+  }
+
+  const Pixel default_pixel;
+  const Pixel* previous_pixel_ref = &default_pixel;
+  FullWidthCache widths;
+  FullWidthCache previous_widths;
+
+  // The position of the terminal cursor, relative to the top-left cell.
+  int cursor_x = 0;
+  int cursor_y = 0;
+
+  const auto move_to = [&](int x, int y) {
+    if (y != cursor_y) {
+      output += "\x1B[";  // MOVE_DOWN
+      AppendNumber(output, y - cursor_y);
+      output += 'B';
+      cursor_y = y;
+    }
+    if (x != cursor_x) {
+      output += "\x1B[";  // MOVE_TO_COLUMN
+      AppendNumber(output, x + 1);
+      output += 'G';
+      cursor_x = x;
+    }
+  };
+
+  for (int y = 0; y < dimy_; ++y) {
+    const Pixel* line = pixels_.data() + y * dimx_;
+    const Pixel* previous_line = previous.pixels_.data() + y * dimx_;
+
+    // Set when the glyph drawn last partially overwrote a fullwidth glyph
+    // previously displayed. The next cell must be redrawn.
+    bool force = false;
+    int x = 0;
+    while (x < dimx_) {
+      const Pixel& pixel = line[x];
+      const int width = widths.IsFullWidth(pixel) ? 2 : 1;
+      if (!force && SamePixel(*this, pixel, previous, previous_line[x])) {
+        x += width;
+        continue;
+      }
+
+      move_to(x, y);
+      UpdatePixelStyle(this, output, *previous_pixel_ref, pixel);
+      previous_pixel_ref = &pixel;
+      if (pixel.character.empty()) {
+        output += ' ';
+      } else {
+        output += pixel.character;
+      }
+      cursor_x += width;
+
+      const int last = std::min(x + width, dimx_) - 1;
+      force = previous_widths.IsFullWidth(previous_line[last]);
+      x += width;
     }
   }
 
   // Reset the style to default:
-  UpdatePixelStyle(this, ss, *previous_pixel_ref, default_pixel);
+  UpdatePixelStyle(this, output, *previous_pixel_ref, default_pixel);
 
-  return ss.str();
+  // Leave the cursor where ToString() would have. Moving to a column past the
+  // end of the terminal is clamped to the last one.
+  move_to(dimx_, dimy_ - 1);
 }
 
 // Print the Screen to the terminal.
@@ -474,21 +730,24 @@ void Screen::Print() const {
 /// @return The string to print in order to reset the cursor position to the
 ///         beginning.
 std::string Screen::ResetPosition(bool clear) const {
-  std::stringstream ss;
+  std::string output;
+  ResetPosition(output, clear);
+  return output;
+}
+
+/// @brief Same as ResetPosition(bool), but append to `output`, reusing its
+/// capacity.
+void Screen::ResetPosition(std::string& output, bool clear) const {
+  output += "\r";  // MOVE_LEFT;
   if (clear) {
-    ss << "\r";       // MOVE_LEFT;
-    ss << "\x1b[2K";  // CLEAR_SCREEN;
-    for (int y = 1; y < dimy_; ++y) {
-      ss << "\x1B[1A";  // MOVE_UP;
-      ss << "\x1B[2K";  // CLEAR_LINE;
-    }
-  } else {
-    ss << "\r";  // MOVE_LEFT;
-    for (int y = 1; y < dimy_; ++y) {
-      ss << "\x1B[1A";  // MOVE_UP;
+    output += "\x1b[2K";  // CLEAR_SCREEN;
+  }
+  for (int y = 1; y < dimy_; ++y) {
+    output += "\x1B[1A";  // MOVE_UP;
+    if (clear) {
+      output += "\x1B[2K";  // CLEAR_LINE;
     }
   }
-  return ss.str();
 }
 
 /// @brief Clear all the pixel from the screen.
@@ -509,19 +768,19 @@ void Screen::ApplyShader() {
   for (int y = 0; y < dimy_; ++y) {
     for (int x = 0; x < dimx_; ++x) {
       // Box drawing character uses exactly 3 byte.
-      Pixel& cur = pixels_[y][x];
+      Pixel& cur = pixels_[y * dimx_ + x];
       if (!ShouldAttemptAutoMerge(cur)) {
         continue;
       }
 
       if (x > 0) {
-        Pixel& left = pixels_[y][x-1];
+        Pixel& left = pixels_[y * dimx_ + x - 1];
         if (ShouldAttemptAutoMerge(left)) {
           UpgradeLeftRight(left.character, cur.character);
         }
       }
       if (y > 0) {
-        Pixel& top = pixels_[y-1][x];
+        Pixel& top = pixels_[(y - 1) * dimx_ + x];
         if (ShouldAttemptAutoMerge(top)) {
           UpgradeTopDown(top.character, cur.character);
         }
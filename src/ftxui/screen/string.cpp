@@ -11,11 +11,12 @@
 
 #include "ftxui/screen/string.hpp"
 
+#include <algorithm>  // for equal, fill, max
 #include <array>    // for array
 #include <cstddef>  // for size_t
-#include <cstdint>  // for uint32_t, uint8_t, uint16_t, int32_t
+#include <cstdint>  // for uint32_t, uint8_t, uint16_t, int32_t, uint64_t
+#include <cstring>  // for memcpy
 #include <string>   // for string, basic_string, wstring
-#include <tuple>    // for _Swallow_assign, ignore
 #include <vector>
 
 #include "ftxui/screen/deprecated.hpp"       // for wchar_width, wstring_width
@@ -1076,75 +1077,120 @@ constexpr std::array<WordBreakPropertyInterval, 993> g_word_break_intervals = {{
     {0xE0100, 0xE01EF, WBP::Extend},
 }};
 
-// Construct table of just WBP::Extend character intervals
-constexpr auto g_extend_characters{[]() constexpr {
-  // Compute number of extend character intervals
-  constexpr size_t size = []() constexpr {
-    size_t count = 0;
-    for (auto interval : g_word_break_intervals) {
-      if (interval.property == WBP::Extend) {
-        count++;
-      }
+// Every codepoint is associated with one byte of properties: its
+// WordBreakProperty, and whether it is fullwidth. Combining characters are the
+// ones with the WBP::Extend property.
+constexpr uint8_t kWordBreakMask = 0b0001'1111;
+constexpr uint8_t kFullWidthBit = 0b1000'0000;
+static_assert(uint8_t(WBP::ZWJ) <= kWordBreakMask);
+
+// Two-level lookup table, giving the properties of a codepoint in O(1).
+//
+// The codepoints are split into blocks of |kBlockSize|. The first level maps a
+// block to an index into the second level, which stores the properties of
+// every codepoint of the block. Most of the blocks are either unassigned or
+// made of a single script, so identical blocks are stored only once. This
+// takes ~40KB, instead of one byte per codepoint.
+class CodepointTable {
+ public:
+  CodepointTable() {
+    // Expand the intervals, one byte per codepoint.
+    std::vector<uint8_t> properties(kEnd, uint8_t(WBP::ALetter));
+    for (const auto& interval : g_word_break_intervals) {
+      std::fill(properties.begin() + interval.first,
+                properties.begin() + interval.last + 1,
+                uint8_t(interval.property));
     }
-    return count;
-  }();
-
-  // Create array of extend character intervals
-  std::array<Interval, size> result{};
-  size_t index = 0;
-  for (auto interval : g_word_break_intervals) {
-    if (interval.property == WBP::Extend) {
-      result[index++] = {interval.first, interval.last};  // NOLINT
+    for (const auto& interval : g_full_width_characters) {
+      for (uint32_t ucs = interval.first; ucs <= interval.last; ++ucs) {
+        properties[ucs] |= kFullWidthBit;  // NOLINT
+      }
     }
-  }
-  return result;
-}()};
 
-// Find a codepoint inside a sorted list of Interval.
-template <size_t N>
-bool Bisearch(uint32_t ucs, const std::array<Interval, N>& table) {
-  if (ucs < table.front().first || ucs > table.back().last) {  // NOLINT
-    return false;
+    // Deduplicate the blocks.
+    index_.resize(kEnd / kBlockSize);
+    for (size_t block = 0; block < index_.size(); ++block) {
+      const auto begin = properties.begin() + block * kBlockSize;
+      const auto end = begin + kBlockSize;
+      size_t i = 0;
+      while (i < blocks_.size() &&
+             !std::equal(begin, end, blocks_.begin() + i)) {
+        i += kBlockSize;
+      }
+      if (i == blocks_.size()) {
+        blocks_.insert(blocks_.end(), begin, end);
+      }
+      index_[block] = uint16_t(i / kBlockSize);
+    }
+    blocks_.shrink_to_fit();
   }
 
-  int min = 0;
-  int max = N - 1;
-  while (max >= min) {
-    const int mid = (min + max) / 2;
-    if (ucs > table[mid].last) {  // NOLINT
-      min = mid + 1;
-    } else if (ucs < table[mid].first) {  // NOLINT
-      max = mid - 1;
-    } else {
-      return true;
+  uint8_t Get(uint32_t ucs) const {
+    if (ucs >= kEnd) {
+      return uint8_t(WBP::ALetter);
     }
+    const size_t block = index_[ucs / kBlockSize];                   // NOLINT
+    return blocks_[block * kBlockSize + ucs % kBlockSize];  // NOLINT
   }
 
-  return false;
+ private:
+  static constexpr uint32_t kBlockSize = 128;
+
+  // Past the last interval, every codepoint has the default properties.
+  static constexpr uint32_t kEnd =
+      (std::max(g_word_break_intervals.back().last,
+                g_full_width_characters.back().last) /
+           kBlockSize +
+       1) *
+      kBlockSize;
+
+  std::vector<uint16_t> index_;
+  std::vector<uint8_t> blocks_;
+};
+
+// The table is built on first use, it takes less than a millisecond.
+const CodepointTable& GetCodepointTable() {
+  static const CodepointTable table;
+  return table;
+}
+
+uint8_t CodepointProperties(uint32_t ucs) {
+  return GetCodepointTable().Get(ucs);
+}
+
+bool IsCombiningProperties(uint8_t properties) {
+  return (properties & kWordBreakMask) == uint8_t(WBP::Extend);
+}
+
+bool IsFullWidthProperties(uint8_t properties) {
+  return (properties & kFullWidthBit) != 0;
 }
 
-// Find a value inside a sorted list of Interval + property.
-template <class C, size_t N>
-bool Bisearch(uint32_t ucs, const std::array<C, N>& table, C* out) {
-  if (ucs < table.front().first || ucs > table.back().last) {  // NOLINT
+// Return whether the 8 bytes starting at |data| are printable ASCII characters,
+// taking one cell each. The bytes are checked all at once, as a single word.
+bool IsPrintableAscii8(const char* data) {
+  constexpr uint64_t kOnes = 0x0101'0101'0101'0101;
+  constexpr uint64_t kHighBits = 0x8080'8080'8080'8080;
+  uint64_t word = 0;
+  std::memcpy(&word, data, sizeof(word));
+
+  // Non ASCII bytes:
+  if (word & kHighBits) {
     return false;
   }
 
-  int min = 0;
-  int max = N - 1;
-  while (max >= min) {
-    const int mid = (min + max) / 2;
-    if (ucs > table[mid].last) {  // NOLINT
-      min = mid + 1;
-    } else if (ucs < table[mid].first) {  // NOLINT
-      max = mid - 1;
-    } else {
-      *out = table[mid];  // NOLINT
-      return true;
-    }
+  // Bytes lower than 0x20, the control characters:
+  if ((word - 0x20 * kOnes) & ~word & kHighBits) {
+    return false;
   }
 
-  return false;
+  // The 0x7F byte, DEL:
+  const uint64_t del = word ^ (0x7F * kOnes);
+  return ((del - kOnes) & ~del & kHighBits) == 0;
+}
+
+bool IsPrintableAscii(uint8_t c) {
+  return c >= 0x20 && c < 0x7F;  // NOLINT
 }
 
 int codepoint_width(uint32_t ucs) {
@@ -1152,11 +1198,12 @@ int codepoint_width(uint32_t ucs) {
     return -1;
   }
 
-  if (ftxui::IsCombining(ucs)) {
+  const uint8_t properties = CodepointProperties(ucs);
+  if (IsCombiningProperties(properties)) {
     return 0;
   }
 
-  if (ftxui::IsFullWidth(ucs)) {
+  if (IsFullWidthProperties(properties)) {
     return 2;
   }
 
@@ -1280,7 +1327,7 @@ bool EatCodePoint(const std::wstring& input,
 }
 
 bool IsCombining(uint32_t ucs) {
-  return Bisearch(ucs, g_extend_characters);
+  return IsCombiningProperties(CodepointProperties(ucs));
 }
 
 bool IsFullWidth(uint32_t ucs) {
@@ -1288,7 +1335,7 @@ bool IsFullWidth(uint32_t ucs) {
     return false;
   }
 
-  return Bisearch(ucs, g_full_width_characters);
+  return IsFullWidthProperties(CodepointProperties(ucs));
 }
 
 bool IsControl(uint32_t ucs) {
@@ -1306,9 +1353,7 @@ bool IsControl(uint32_t ucs) {
 }
 
 WordBreakProperty CodepointToWordBreakProperty(uint32_t codepoint) {
-  WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
-  std::ignore = Bisearch(codepoint, g_word_break_intervals, &interval);
-  return interval.property;
+  return WBP(CodepointProperties(codepoint) & kWordBreakMask);
 }
 
 int wchar_width(wchar_t ucs) {
@@ -1332,6 +1377,14 @@ int string_width(const std::string& input) {
   int width = 0;
   size_t start = 0;
   while (start < input.size()) {
+    // Fast path: 8 printable ASCII characters at once.
+    if (start + 8 <= input.size() &&  // NOLINT
+        IsPrintableAscii8(input.data() + start)) {
+      width += 8;  // NOLINT
+      start += 8;  // NOLINT
+      continue;
+    }
+
     uint32_t codepoint = 0;
     if (!EatCodePoint(input, start, &start, &codepoint)) {
       continue;
@@ -1341,11 +1394,12 @@ int string_width(const std::string& input) {
       continue;
     }
 
-    if (IsCombining(codepoint)) {
+    const uint8_t properties = CodepointProperties(codepoint);
+    if (IsCombiningProperties(properties)) {
       continue;
     }
 
-    if (IsFullWidth(codepoint)) {
+    if (IsFullWidthProperties(properties)) {
       width += 2;
       continue;
     }
@@ -1361,6 +1415,13 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
   size_t start = 0;
   size_t end = 0;
   while (start < input.size()) {
+    // Fast path: printable ASCII characters.
+    if (IsPrintableAscii(input[start])) {
+      out.emplace_back(1, input[start]);
+      ++start;
+      continue;
+    }
+
     uint32_t codepoint = 0;
     if (!EatCodePoint(input, start, &end, &codepoint)) {
       start = end;
@@ -1376,7 +1437,8 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
     }
 
     // Combining characters are put with the previous glyph they are modifying.
-    if (IsCombining(codepoint)) {
+    const uint8_t properties = CodepointProperties(codepoint);
+    if (IsCombiningProperties(properties)) {
       if (!out.empty()) {
         out.back() += append;
       }
@@ -1385,7 +1447,7 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
 
     // Fullwidth characters take two cells. The second is made of the empty
     // string to reserve the space the first is taking.
-    if (IsFullWidth(codepoint)) {
+    if (IsFullWidthProperties(properties)) {
       out.push_back(append);
       out.emplace_back("");
       continue;
@@ -1397,6 +1459,59 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
   return out;
 }
 
+void Utf8ToPackedGlyphs(const std::string& input,
+                        std::string* glyphs,
+                        std::vector<uint32_t>* offsets) {
+  glyphs->clear();
+  glyphs->reserve(input.size());
+  offsets->clear();
+  offsets->reserve(input.size() + 1);
+  offsets->push_back(0);
+  size_t start = 0;
+  size_t end = 0;
+  while (start < input.size()) {
+    // Fast path: printable ASCII characters.
+    if (IsPrintableAscii(input[start])) {
+      glyphs->push_back(input[start]);
+      offsets->push_back(uint32_t(glyphs->size()));
+      ++start;
+      continue;
+    }
+
+    uint32_t codepoint = 0;
+    if (!EatCodePoint(input, start, &end, &codepoint)) {
+      start = end;
+      continue;
+    }
+
+    const size_t begin = start;
+    start = end;
+
+    // Ignore control characters.
+    if (IsControl(codepoint)) {
+      continue;
+    }
+
+    // Combining characters are put with the previous glyph they are modifying.
+    const uint8_t properties = CodepointProperties(codepoint);
+    if (IsCombiningProperties(properties)) {
+      if (offsets->size() > 1) {
+        glyphs->append(input, begin, end - begin);
+        offsets->back() = uint32_t(glyphs->size());
+      }
+      continue;
+    }
+
+    glyphs->append(input, begin, end - begin);
+    offsets->push_back(uint32_t(glyphs->size()));
+
+    // Fullwidth characters take two cells. The second is the empty glyph.
+    if (IsFullWidthProperties(properties)) {
+      offsets->push_back(uint32_t(glyphs->size()));
+    }
+  }
+}
+
 size_t GlyphPrevious(const std::string& input, size_t start) {
   while (true) {
     if (start == 0) {
@@ -1508,6 +1623,14 @@ int GlyphCount(const std::string& input) {
   size_t start = 0;
   size_t end = 0;
   while (start < input.size()) {
+    // Fast path: 8 printable ASCII characters at once.
+    if (start + 8 <= input.size() &&  // NOLINT
+        IsPrintableAscii8(input.data() + start)) {
+      size += 8;   // NOLINT
+      start += 8;  // NOLINT
+      continue;
+    }
+
     uint32_t codepoint = 0;
     const bool eaten = EatCodePoint(input, start, &end, &codepoint);
     start = end;
@@ -1555,9 +1678,7 @@ std::vector<WordBreakProperty> Utf8ToWordBreakProperty(
       continue;
     }
 
-    WordBreakPropertyInterval interval = {0, 0, WBP::ALetter};
-    std::ignore = Bisearch(codepoint, g_word_break_intervals, &interval);
-    out.push_back(interval.property);
+    out.push_back(CodepointToWordBreakProperty(codepoint));
   }
   return out;
 }
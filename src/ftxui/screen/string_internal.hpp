@@ -35,6 +35,13 @@ size_t GlyphIterate(const std::string& input,
 // Returns the number of glyphs in |input|.
 int GlyphCount(const std::string& input);
 
+// Same as Utf8ToGlyphs(input), without allocating one string per glyph. The
+// glyphs are concatenated into |glyphs|. The i-th glyph is made of the bytes
+// in between |offsets[i]| and |offsets[i+1]|.
+void Utf8ToPackedGlyphs(const std::string& input,
+                        std::string* glyphs,
+                        std::vector<uint32_t>* offsets);
+
 // Properties from:
 // https://www.unicode.org/Public/UCD/latest/ucd/auxiliary/WordBreakProperty.txt
 enum class WordBreakProperty : int8_t {
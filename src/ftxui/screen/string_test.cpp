@@ -48,6 +48,30 @@ TEST(StringTest, Utf8ToGlyphs) {
   EXPECT_EQ(Utf8ToGlyphs("a\1a"), T({"a", "a"}));
 }
 
+TEST(StringTest, Utf8ToPackedGlyphs) {
+  for (const std::string input : {
+           "",
+           "ab",
+           "测试",
+           "ā",
+           "a⃒b",
+           "测̗a",
+           "\1a\1\na",
+           "̗a",
+       }) {
+    std::string glyphs;
+    std::vector<uint32_t> offsets;
+    Utf8ToPackedGlyphs(input, &glyphs, &offsets);
+
+    std::vector<std::string> unpacked;
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+      unpacked.push_back(
+          glyphs.substr(offsets[i], offsets[i + 1] - offsets[i]));
+    }
+    EXPECT_EQ(unpacked, Utf8ToGlyphs(input)) << input;
+  }
+}
+
 TEST(StringTest, GlyphCount) {
   // Basic:
   EXPECT_EQ(GlyphCount(""), 0);